@@ -8,74 +8,151 @@ echo "Project dir: $PROJECT_DIR"
 echo "Build dir: $BUILD_DIR"
 mkdir -p "$BUILD_DIR"
 echo ""
-echo "[1/11] Compiling memory.cpp..."
-g++ -c -O2 -march=x86-64 -fno-exceptions \
+echo "[1/22] Compiling memory.cpp..."
+g++ -c -O2 -march=x86-64 -fno-exceptions -pthread \
     "$PROJECT_DIR/src/lib/memory.cpp" \
     -o "$BUILD_DIR/memory.o" \
     -I"$PROJECT_DIR/src" \
     2>&1
-echo "[2/11] Compiling Number.cpp..."
-g++ -c -O2 -march=x86-64 -fno-exceptions \
+echo "[2/22] Compiling parallel.cpp..."
+g++ -c -O2 -march=x86-64 -fno-exceptions -pthread \
+    "$PROJECT_DIR/src/lib/parallel.cpp" \
+    -o "$BUILD_DIR/parallel.o" \
+    -I"$PROJECT_DIR/src" \
+    2>&1
+echo "[3/22] Compiling search.cpp..."
+g++ -c -O2 -march=x86-64 -fno-exceptions -pthread \
+    "$PROJECT_DIR/src/lib/search.cpp" \
+    -o "$BUILD_DIR/search.o" \
+    -I"$PROJECT_DIR/src" \
+    2>&1
+echo "[4/22] Compiling intern.cpp..."
+g++ -c -O2 -march=x86-64 -fno-exceptions -pthread \
+    "$PROJECT_DIR/src/lib/intern.cpp" \
+    -o "$BUILD_DIR/intern.o" \
+    -I"$PROJECT_DIR/src" \
+    2>&1
+echo "[5/22] Compiling cpu.cpp..."
+g++ -c -O2 -march=x86-64 -fno-exceptions -pthread \
+    "$PROJECT_DIR/src/lib/cpu.cpp" \
+    -o "$BUILD_DIR/cpu.o" \
+    -I"$PROJECT_DIR/src" \
+    2>&1
+echo "[6/22] Compiling unicode.cpp..."
+g++ -c -O2 -march=x86-64 -fno-exceptions -pthread \
+    "$PROJECT_DIR/src/lib/unicode.cpp" \
+    -o "$BUILD_DIR/unicode.o" \
+    -I"$PROJECT_DIR/src" \
+    2>&1
+echo "[7/22] Compiling Number.cpp..."
+g++ -c -O2 -march=x86-64 -fno-exceptions -pthread \
     "$PROJECT_DIR/src/types/Number.cpp" \
     -o "$BUILD_DIR/Number.o" \
     -I"$PROJECT_DIR/src" \
     2>&1
-echo "[3/11] Compiling Boolean.cpp..."
-g++ -c -O2 -march=x86-64 -fno-exceptions \
+echo "[8/22] Compiling Boolean.cpp..."
+g++ -c -O2 -march=x86-64 -fno-exceptions -pthread \
     "$PROJECT_DIR/src/types/Boolean.cpp" \
     -o "$BUILD_DIR/Boolean.o" \
     -I"$PROJECT_DIR/src" \
     2>&1
-echo "[4/11] Compiling Array.cpp..."
-g++ -c -O2 -march=x86-64 -fno-exceptions \
+echo "[9/22] Compiling BooleanArray.cpp..."
+g++ -c -O2 -march=x86-64 -fno-exceptions -pthread \
+    "$PROJECT_DIR/src/types/BooleanArray.cpp" \
+    -o "$BUILD_DIR/BooleanArray.o" \
+    -I"$PROJECT_DIR/src" \
+    2>&1
+echo "[10/22] Compiling Array.cpp..."
+g++ -c -O2 -march=x86-64 -fno-exceptions -pthread \
     "$PROJECT_DIR/src/types/Array.cpp" \
     -o "$BUILD_DIR/Array.o" \
     -I"$PROJECT_DIR/src" \
     2>&1
-echo "[5/11] Compiling Char.cpp..."
-g++ -c -O2 -march=x86-64 -fno-exceptions \
+echo "[11/22] Compiling ArrayOf.cpp..."
+g++ -c -O2 -march=x86-64 -fno-exceptions -pthread \
+    "$PROJECT_DIR/src/types/ArrayOf.cpp" \
+    -o "$BUILD_DIR/ArrayOf.o" \
+    -I"$PROJECT_DIR/src" \
+    2>&1
+echo "[12/22] Compiling PersistentVector.cpp..."
+g++ -c -O2 -march=x86-64 -fno-exceptions -pthread \
+    "$PROJECT_DIR/src/types/PersistentVector.cpp" \
+    -o "$BUILD_DIR/PersistentVector.o" \
+    -I"$PROJECT_DIR/src" \
+    2>&1
+echo "[13/22] Compiling Deque.cpp..."
+g++ -c -O2 -march=x86-64 -fno-exceptions -pthread \
+    "$PROJECT_DIR/src/types/Deque.cpp" \
+    -o "$BUILD_DIR/Deque.o" \
+    -I"$PROJECT_DIR/src" \
+    2>&1
+echo "[14/22] Compiling Char.cpp..."
+g++ -c -O2 -march=x86-64 -fno-exceptions -pthread \
     "$PROJECT_DIR/src/types/Char.cpp" \
     -o "$BUILD_DIR/Char.o" \
     -I"$PROJECT_DIR/src" \
     2>&1
-echo "[6/11] Compiling Strings.cpp..."
-g++ -c -O2 -march=x86-64 -fno-exceptions \
+echo "[15/22] Compiling Strings.cpp..."
+g++ -c -O2 -march=x86-64 -fno-exceptions -pthread \
     "$PROJECT_DIR/src/types/Strings.cpp" \
     -o "$BUILD_DIR/Strings.o" \
     -I"$PROJECT_DIR/src" \
     2>&1
-echo "[7/11] Compiling console.cpp..."
-g++ -c -O2 -march=x86-64 -fno-exceptions \
+echo "[16/22] Compiling Map.cpp..."
+g++ -c -O2 -march=x86-64 -fno-exceptions -pthread \
+    "$PROJECT_DIR/src/types/Map.cpp" \
+    -o "$BUILD_DIR/Map.o" \
+    -I"$PROJECT_DIR/src" \
+    2>&1
+echo "[17/22] Compiling Object.cpp..."
+g++ -c -O2 -march=x86-64 -fno-exceptions -pthread \
+    "$PROJECT_DIR/src/types/Object.cpp" \
+    -o "$BUILD_DIR/Object.o" \
+    -I"$PROJECT_DIR/src" \
+    2>&1
+echo "[18/22] Compiling console.cpp..."
+g++ -c -O2 -march=x86-64 -fno-exceptions -pthread \
     "$PROJECT_DIR/src/lib/console.cpp" \
     -o "$BUILD_DIR/console.o" \
     -I"$PROJECT_DIR/src" \
     2>&1
-echo "[8/11] Compiling math.cpp..."
-g++ -c -O2 -march=x86-64 -fno-exceptions \
+echo "[19/22] Compiling math.cpp..."
+g++ -c -O2 -march=x86-64 -fno-exceptions -pthread \
     "$PROJECT_DIR/src/lib/math.cpp" \
     -o "$BUILD_DIR/math.o" \
     -I"$PROJECT_DIR/src" \
     2>&1
-echo "[9/11] Compiling main.cpp..."
-g++ -c -O2 -march=x86-64 -fno-exceptions \
+echo "[20/22] Compiling main.cpp..."
+g++ -c -O2 -march=x86-64 -fno-exceptions -pthread \
     "$PROJECT_DIR/src/main.cpp" \
     -o "$BUILD_DIR/main.o" \
     -I"$PROJECT_DIR/src" \
     2>&1
-echo "[10/11] Linking executable..."
-g++ -O2 -fno-exceptions \
+echo "[21/22] Linking executable..."
+g++ -O2 -fno-exceptions -pthread \
     "$BUILD_DIR/memory.o" \
+    "$BUILD_DIR/parallel.o" \
+    "$BUILD_DIR/search.o" \
+    "$BUILD_DIR/intern.o" \
+    "$BUILD_DIR/cpu.o" \
+    "$BUILD_DIR/unicode.o" \
     "$BUILD_DIR/Number.o" \
     "$BUILD_DIR/Boolean.o" \
+    "$BUILD_DIR/BooleanArray.o" \
     "$BUILD_DIR/Array.o" \
+    "$BUILD_DIR/ArrayOf.o" \
+    "$BUILD_DIR/PersistentVector.o" \
+    "$BUILD_DIR/Deque.o" \
     "$BUILD_DIR/Char.o" \
     "$BUILD_DIR/Strings.o" \
+    "$BUILD_DIR/Map.o" \
+    "$BUILD_DIR/Object.o" \
     "$BUILD_DIR/console.o" \
     "$BUILD_DIR/math.o" \
     "$BUILD_DIR/main.o" \
     -o "$OUTPUT" \
     2>&1
-echo "[11/11] Running tests..."
+echo "[22/22] Running tests..."
 echo ""
 if [ -f "$OUTPUT" ]; then
     "$OUTPUT"
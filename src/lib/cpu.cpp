@@ -0,0 +1,48 @@
+#include "cpu.hpp"
+
+namespace Luna {
+namespace Cpu {
+
+/**
+ * @brief Cached feature flags, probed once on first use
+ */
+struct Features {
+    bool probed;
+    bool popcnt;
+    bool sse42;
+    bool avx2;
+    bool avx512;
+};
+
+static Features g_features = {false, false, false, false, false};
+
+static const Features& features() {
+    if (!g_features.probed) {
+        __builtin_cpu_init();
+        g_features.popcnt = __builtin_cpu_supports("popcnt");
+        g_features.sse42 = __builtin_cpu_supports("sse4.2");
+        g_features.avx2 = __builtin_cpu_supports("avx2");
+        g_features.avx512 = __builtin_cpu_supports("avx512f") && __builtin_cpu_supports("avx512bw");
+        g_features.probed = true;
+    }
+    return g_features;
+}
+
+bool hasPopcnt() {
+    return features().popcnt;
+}
+
+bool hasSse42() {
+    return features().sse42;
+}
+
+bool hasAvx2() {
+    return features().avx2;
+}
+
+bool hasAvx512() {
+    return features().avx512;
+}
+
+} // namespace Cpu
+} // namespace Luna
@@ -0,0 +1,27 @@
+#pragma once
+
+namespace Luna {
+namespace Cpu {
+
+/**
+ * @brief Check if the CPU supports POPCNT
+ */
+bool hasPopcnt();
+
+/**
+ * @brief Check if the CPU supports SSE4.2
+ */
+bool hasSse42();
+
+/**
+ * @brief Check if the CPU (and OS) support AVX2
+ */
+bool hasAvx2();
+
+/**
+ * @brief Check if the CPU (and OS) support AVX-512 Foundation + BW
+ */
+bool hasAvx512();
+
+} // namespace Cpu
+} // namespace Luna
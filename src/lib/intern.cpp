@@ -0,0 +1,109 @@
+#include "intern.hpp"
+#include "types/Map.hpp"
+#include <pthread.h>
+#include <new>
+
+namespace Luna {
+
+// ===== TABLE =====
+// The table is split into shards by the top bits of the hash, each behind
+// its own mutex, so threads interning different strings rarely contend.
+
+namespace {
+
+const size_t SHARD_BITS = 6;
+const size_t SHARD_COUNT = (size_t)1 << SHARD_BITS;
+
+/**
+ * @brief Lookup key: the bytes being interned or those of a stored entry
+ */
+struct InternKey {
+    const char* data;
+    size_t length;
+    uint64_t hash;
+};
+
+} // namespace
+
+template<>
+struct HashTraits<InternKey> {
+    static uint64_t hash(const InternKey& key) { return key.hash; }
+    static bool equals(const InternKey& a, const InternKey& b) {
+        return a.length == b.length && Memory::compare(a.data, b.data, a.length) == 0;
+    }
+};
+
+namespace {
+
+struct Shard {
+    pthread_mutex_t lock;
+    Map<InternKey, const Interned::Entry*> entries;
+};
+
+// Built on first use and never destroyed: handles stay valid through exit
+alignas(Shard) unsigned char shard_storage[SHARD_COUNT * sizeof(Shard)];
+Shard* shards = nullptr;
+pthread_once_t init_once = PTHREAD_ONCE_INIT;
+
+void createShards() {
+    Shard* created = (Shard*)shard_storage;
+    for (size_t i = 0; i < SHARD_COUNT; i++) {
+        new (&created[i].entries) Map<InternKey, const Interned::Entry*>();
+        pthread_mutex_init(&created[i].lock, nullptr);
+    }
+    shards = created;
+}
+
+Shard& shardFor(uint64_t hash) {
+    pthread_once(&init_once, createShards);
+    return shards[hash >> (64 - SHARD_BITS)];
+}
+
+} // namespace
+
+uint64_t Interned::emptyHash() {
+    return Hash::bytes("", 0);
+}
+
+Interned Interned::of(const char* data, size_t length) {
+    if (length == 0) return Interned();
+
+    InternKey key = { data, length, Hash::bytes(data, length) };
+    Shard& shard = shardFor(key.hash);
+
+    pthread_mutex_lock(&shard.lock);
+    const Entry* const* found = shard.entries.get(key);
+    const Entry* entry = found ? *found : nullptr;
+    if (!entry) {
+        Entry* created = (Entry*)Memory::allocate(sizeof(Entry) + length + 1);
+        created->hash = key.hash;
+        created->length = length;
+        char* bytes = (char*)(created + 1);
+        Memory::copy(bytes, data, length);
+        bytes[length] = '\0';
+
+        // The stored key points at the entry's own copy of the bytes
+        key.data = bytes;
+        shard.entries.set(key, created);
+        entry = created;
+    }
+    pthread_mutex_unlock(&shard.lock);
+    return Interned(entry);
+}
+
+Interned Interned::of(const char* cstr) {
+    return cstr ? of(cstr, string::length(cstr)) : Interned();
+}
+
+size_t Interned::count() {
+    pthread_once(&init_once, createShards);
+    size_t total = 0;
+    for (size_t i = 0; i < SHARD_COUNT; i++) {
+        pthread_mutex_lock(&shards[i].lock);
+        total += shards[i].entries.getSize();
+        pthread_mutex_unlock(&shards[i].lock);
+    }
+    return total;
+}
+
+} // namespace Luna
@@ -0,0 +1,63 @@
+#pragma once
+
+#include "memory.hpp"
+
+typedef unsigned long uint64_t;
+
+namespace Luna {
+
+/**
+ * @brief Canonical handle to a string in the global intern table
+ *
+ * Interning equal bytes always yields the same handle, so handles compare
+ * by pointer in O(1). The bytes are immutable, NUL-terminated and live for
+ * the whole process, and the hash is computed once, on first interning.
+ * The default handle is the empty string. Interning is thread-safe.
+ */
+class Interned {
+public:
+    struct Entry {
+        uint64_t hash;  // Hash::bytes of the contents
+        size_t length;
+        // Followed by length bytes and a NUL
+    };
+
+private:
+    const Entry* entry; // nullptr for the empty string
+
+    explicit Interned(const Entry* entry) : entry(entry) {}
+
+    static uint64_t emptyHash();
+
+public:
+    Interned() : entry(nullptr) {}
+
+    /**
+     * @brief Canonical handle for data[0, length)
+     */
+    static Interned of(const char* data, size_t length);
+
+    /**
+     * @brief Canonical handle for a C-string
+     */
+    static Interned of(const char* cstr);
+
+    /**
+     * @brief Number of distinct non-empty strings interned so far
+     */
+    static size_t count();
+
+    const char* c_str() const { return entry ? (const char*)(entry + 1) : ""; }
+    size_t length() const { return entry ? entry->length : 0; }
+    bool empty() const { return entry == nullptr; }
+
+    /**
+     * @brief Precomputed hash, equal to Hash::bytes of the contents
+     */
+    uint64_t hash() const { return entry ? entry->hash : emptyHash(); }
+
+    bool operator==(const Interned& other) const { return entry == other.entry; }
+    bool operator!=(const Interned& other) const { return entry != other.entry; }
+};
+
+} // namespace Luna
@@ -7,6 +7,7 @@
 #include <cmath>
 #include <cstdlib>
 #include <cstdarg>
+#include <emmintrin.h>
 
 namespace Luna {
 namespace Math {
@@ -216,6 +217,105 @@ Number max(const Array& values) {
     return max_val;
 }
 
+// ===== TYPED ARRAY REDUCTIONS =====
+// SSE2 is baseline on x86-64, so these kernels need no dispatch.
+
+static double reduceDoubles(const double* values, size_t count, bool want_min) {
+    __m128d acc = _mm_set1_pd(values[0]);
+    __m128d unordered = _mm_setzero_pd();
+    size_t i = 0;
+
+    for (; i + 2 <= count; i += 2) {
+        __m128d v = _mm_loadu_pd(values + i);
+        unordered = _mm_or_pd(unordered, _mm_cmpunord_pd(v, v));
+        acc = want_min ? _mm_min_pd(v, acc) : _mm_max_pd(v, acc);
+    }
+    if (_mm_movemask_pd(unordered)) return NAN;
+
+    double lanes[2];
+    _mm_storeu_pd(lanes, acc);
+    double result = lanes[0];
+    if (want_min ? lanes[1] < result : lanes[1] > result) result = lanes[1];
+
+    for (; i < count; i++) {
+        double v = values[i];
+        if (v != v) return NAN;
+        if (want_min ? v < result : v > result) result = v;
+    }
+    return result;
+}
+
+static int32_t reduceInt32s(const int32_t* values, size_t count, bool want_min) {
+    int32_t result = values[0];
+    size_t i = 0;
+
+    if (count >= 4) {
+        __m128i acc = _mm_loadu_si128((const __m128i*)values);
+        for (i = 4; i + 4 <= count; i += 4) {
+            __m128i v = _mm_loadu_si128((const __m128i*)(values + i));
+            // No pminsd/pmaxsd before SSE4.1: select with a compare mask
+            __m128i take = want_min ? _mm_cmpgt_epi32(acc, v) : _mm_cmpgt_epi32(v, acc);
+            acc = _mm_or_si128(_mm_and_si128(take, v), _mm_andnot_si128(take, acc));
+        }
+
+        int32_t lanes[4];
+        _mm_storeu_si128((__m128i*)lanes, acc);
+        result = lanes[0];
+        for (int k = 1; k < 4; k++) {
+            if (want_min ? lanes[k] < result : lanes[k] > result) result = lanes[k];
+        }
+    }
+
+    for (; i < count; i++) {
+        if (want_min ? values[i] < result : values[i] > result) result = values[i];
+    }
+    return result;
+}
+
+Number min(const ArrayOf<double>& values) {
+    if (values.isEmpty()) return Number::nan();
+    return Number(reduceDoubles(values.getData(), values.getLength(), true));
+}
+
+Number max(const ArrayOf<double>& values) {
+    if (values.isEmpty()) return Number::nan();
+    return Number(reduceDoubles(values.getData(), values.getLength(), false));
+}
+
+Number min(const ArrayOf<int32_t>& values) {
+    if (values.isEmpty()) return Number::nan();
+    return Number(reduceInt32s(values.getData(), values.getLength(), true));
+}
+
+Number max(const ArrayOf<int32_t>& values) {
+    if (values.isEmpty()) return Number::nan();
+    return Number(reduceInt32s(values.getData(), values.getLength(), false));
+}
+
+Number min(const ArrayOf<Number>& values) {
+    if (values.isEmpty()) return Number::nan();
+
+    const Number* items = values.getData();
+    Number min_val = items[0];
+    for (size_t i = 1; i < values.getLength(); i++) {
+        if (items[i].isNaN()) return Number::nan();
+        if (items[i].lessThan(min_val)) min_val = items[i];
+    }
+    return min_val.isNaN() ? Number::nan() : min_val;
+}
+
+Number max(const ArrayOf<Number>& values) {
+    if (values.isEmpty()) return Number::nan();
+
+    const Number* items = values.getData();
+    Number max_val = items[0];
+    for (size_t i = 1; i < values.getLength(); i++) {
+        if (items[i].isNaN()) return Number::nan();
+        if (items[i].greaterThan(max_val)) max_val = items[i];
+    }
+    return max_val.isNaN() ? Number::nan() : max_val;
+}
+
 Number random() {
     return Number((double)::rand() / RAND_MAX);
 }
@@ -230,25 +330,13 @@ Number randomRange(const Number& min, const Number& max) {
 // ===== SYMBOLIC EXPRESSION IMPLEMENTATIONS =====
 
 // Symbol implementation
-Symbol::Symbol(const char* var_name) {
-    name = string::duplicate(var_name);
-}
-
-Symbol::Symbol(const Symbol& other) {
-    name = string::duplicate(other.name);
-}
-
-Symbol::~Symbol() {
-    if (name) {
-        string::free(name);
-    }
-}
+Symbol::Symbol(const char* var_name) : name(Interned::of(var_name)) {}
 
 Number Symbol::evaluate(const Array& variables) const {
     // Look for variable value in the provided array
     for (size_t i = 0; i < variables.getLength(); i += 2) {
         Symbol* var = (Symbol*)variables.get(i);
-        if (var && string::compare(var->getName(), name) == 0) {
+        if (var && var->name == name) {
             Number* value = (Number*)variables.get(i + 1);
             return *value;
         }
@@ -259,11 +347,11 @@ Number Symbol::evaluate(const Array& variables) const {
 }
 
 char* Symbol::toString() const {
-    return string::duplicate(name);
+    return string::duplicate(name.c_str());
 }
 
 SymbolicExpr* Symbol::diff(const char* variable) const {
-    if (string::compare(name, variable) == 0) {
+    if (string::compare(name.c_str(), variable) == 0) {
         return new Constant(Number(1));
     } else {
         return new Constant(Number(0));
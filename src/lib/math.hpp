@@ -3,7 +3,9 @@
 
 #include "../types/Number.hpp"
 #include "../types/Array.hpp"
+#include "../types/ArrayOf.hpp"
 #include "memory.hpp"
+#include "intern.hpp"
 #include <cmath>
 
 namespace Luna {
@@ -79,6 +81,16 @@ Number max(const Number& a, const Number& b);
 Number min(const Array& values);
 Number max(const Array& values);
 
+/**
+ * @brief Minimum and maximum over unboxed storage (NaN if any element is NaN)
+ */
+Number min(const ArrayOf<double>& values);
+Number max(const ArrayOf<double>& values);
+Number min(const ArrayOf<int32_t>& values);
+Number max(const ArrayOf<int32_t>& values);
+Number min(const ArrayOf<Number>& values);
+Number max(const ArrayOf<Number>& values);
+
 /**
  * @brief Random number generation
  */
@@ -130,12 +142,10 @@ public:
  */
 class Symbol : public SymbolicExpr {
 private:
-    char* name;
+    Interned name; // Symbols with the same name share one handle
     
 public:
     Symbol(const char* var_name);
-    Symbol(const Symbol& other);
-    ~Symbol();
     
     Number evaluate(const Array& variables) const override;
     char* toString() const override;
@@ -144,7 +154,12 @@ public:
     bool isConstant() const override;
     SymbolicExpr* copy() const override;
     
-    const char* getName() const { return name; }
+    const char* getName() const { return name.c_str(); }
+    
+    /**
+     * @brief Interned name, for O(1) comparison with other symbols
+     */
+    Interned getInternedName() const { return name; }
 };
 
 /**
@@ -45,6 +45,20 @@ void shutdown() {
     }
 }
 
+#ifndef LUNA_USE_STDLIB
+/**
+ * @brief Update allocation statistics (safe from pool worker threads)
+ */
+static void recordAllocation(size_t size) {
+    size_t total = __atomic_add_fetch(&g_memory_manager.total_allocated, size, __ATOMIC_RELAXED);
+    size_t peak = __atomic_load_n(&g_memory_manager.peak_allocated, __ATOMIC_RELAXED);
+    while (total > peak &&
+           !__atomic_compare_exchange_n(&g_memory_manager.peak_allocated, &peak, total,
+                                        true, __ATOMIC_RELAXED, __ATOMIC_RELAXED)) {
+    }
+}
+#endif
+
 void* allocate(size_t size) {
     if (!g_memory_manager.initialized) {
         initialize();
@@ -63,10 +77,7 @@ void* allocate(size_t size) {
     ptr = malloc(size);  // FIXED: Use heap allocation instead of stack
     
     if (ptr) {
-        g_memory_manager.total_allocated += size;
-        if (g_memory_manager.total_allocated > g_memory_manager.peak_allocated) {
-            g_memory_manager.peak_allocated = g_memory_manager.total_allocated;
-        }
+        recordAllocation(size);
     }
 #endif
 
@@ -99,10 +110,7 @@ void* reallocate(void* ptr, size_t new_size) {
     if (new_ptr) {
         // Update allocation tracking
         // Note: This is approximate since we don't know the old size
-        g_memory_manager.total_allocated += new_size;
-        if (g_memory_manager.total_allocated > g_memory_manager.peak_allocated) {
-            g_memory_manager.peak_allocated = g_memory_manager.total_allocated;
-        }
+        recordAllocation(new_size);
     }
     return new_ptr;
 #endif
@@ -131,6 +139,53 @@ void copy(void* dest, const void* src, size_t n) {
 #endif
 }
 
+void move(void* dest, const void* src, size_t n) {
+    if (!dest || !src || n == 0 || dest == src) return;
+
+    char* d = (char*)dest;
+    const char* s = (const char*)src;
+
+    // Forward copy is safe unless dest starts inside the source range
+    if (d < s || d >= s + n) {
+        copy(dest, src, n);
+        return;
+    }
+
+#ifdef LUNA_USE_STDLIB
+    for (size_t i = n; i > 0; i--) {
+        d[i - 1] = s[i - 1];
+    }
+#else
+    // Backward copy: odd tail bytes first, then whole qwords
+    size_t words = n >> 3;
+    size_t tail = n & 7;
+    if (tail > 0) {
+        const char* s_end = s + n - 1;
+        char* d_end = d + n - 1;
+        __asm__ volatile (
+            "std\n"
+            "rep movsb\n"
+            "cld\n"
+            : "+S" (s_end), "+D" (d_end), "+c" (tail)
+            :
+            : "memory"
+        );
+    }
+    if (words > 0) {
+        const char* s_word = s + (words - 1) * 8;
+        char* d_word = d + (words - 1) * 8;
+        __asm__ volatile (
+            "std\n"
+            "rep movsq\n"
+            "cld\n"
+            : "+S" (s_word), "+D" (d_word), "+c" (words)
+            :
+            : "memory"
+        );
+    }
+#endif
+}
+
 void set(void* dest, int value, size_t n) {
     if (!dest || n == 0) return;
 
@@ -218,6 +273,13 @@ extern "C" {
         Luna::Memory::copy(dest, src, n);
     }
     
+    /**
+     * @brief C interface for overlapping memory move
+     */
+    void luna_memmove(void* dest, void* src, size_t n) {
+        Luna::Memory::move(dest, src, n);
+    }
+    
     /**
      * @brief C interface for memory set
      */
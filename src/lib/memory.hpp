@@ -39,6 +39,14 @@ void* reallocate(void* ptr, size_t new_size);
  */
 void copy(void* dest, const void* src, size_t n);
 
+/**
+ * @brief Copy memory between possibly overlapping regions
+ * @param dest - Destination pointer
+ * @param src - Source pointer
+ * @param n - Number of bytes to move
+ */
+void move(void* dest, const void* src, size_t n);
+
 /**
  * @brief Set memory to value
  * @param dest - Destination pointer
@@ -0,0 +1,217 @@
+#include "parallel.hpp"
+#include <pthread.h>
+#include <sched.h>
+#include <unistd.h>
+
+namespace Luna {
+namespace Parallel {
+
+// ===== POOL STATE =====
+
+namespace {
+
+const size_t MAX_THREADS = 64;
+const size_t QUEUE_CAPACITY = 256;
+
+struct Job {
+    RangeFn fn;
+    void* context;
+    size_t grain;
+    size_t remaining; // Indices not yet processed
+};
+
+struct Task {
+    Job* job;
+    size_t begin;
+    size_t end;
+};
+
+/**
+ * @brief Per-thread deque: the owner pushes and pops at the tail,
+ *        thieves take from the head (the oldest, largest ranges)
+ */
+struct WorkQueue {
+    pthread_mutex_t lock;
+    Task tasks[QUEUE_CAPACITY];
+    size_t head;
+    size_t tail;
+};
+
+WorkQueue queues[MAX_THREADS];
+size_t thread_count = 1;
+
+pthread_once_t init_once = PTHREAD_ONCE_INIT;
+pthread_mutex_t dispatch_lock = PTHREAD_MUTEX_INITIALIZER;
+pthread_mutex_t wake_lock = PTHREAD_MUTEX_INITIALIZER;
+pthread_cond_t wake_cond = PTHREAD_COND_INITIALIZER;
+unsigned long generation = 0;
+int job_active = 0;
+
+// Slot 0 belongs to whichever thread holds dispatch_lock
+__thread size_t slot = 0;
+__thread bool in_task = false;
+
+bool push(size_t self, const Task& task) {
+    WorkQueue& queue = queues[self];
+    pthread_mutex_lock(&queue.lock);
+    bool ok = queue.tail - queue.head < QUEUE_CAPACITY;
+    if (ok) {
+        queue.tasks[queue.tail % QUEUE_CAPACITY] = task;
+        __atomic_store_n(&queue.tail, queue.tail + 1, __ATOMIC_RELAXED);
+    }
+    pthread_mutex_unlock(&queue.lock);
+    return ok;
+}
+
+bool pop(size_t self, Task* task) {
+    WorkQueue& queue = queues[self];
+    pthread_mutex_lock(&queue.lock);
+    bool ok = queue.tail > queue.head;
+    if (ok) {
+        __atomic_store_n(&queue.tail, queue.tail - 1, __ATOMIC_RELAXED);
+        *task = queue.tasks[queue.tail % QUEUE_CAPACITY];
+    }
+    pthread_mutex_unlock(&queue.lock);
+    return ok;
+}
+
+bool steal(size_t self, Task* task) {
+    for (size_t offset = 1; offset < thread_count; offset++) {
+        WorkQueue& queue = queues[(self + offset) % thread_count];
+        // Unlocked peek: skipping a queue that just filled is harmless
+        if (__atomic_load_n(&queue.tail, __ATOMIC_RELAXED) == __atomic_load_n(&queue.head, __ATOMIC_RELAXED)) {
+            continue;
+        }
+
+        pthread_mutex_lock(&queue.lock);
+        bool ok = queue.tail > queue.head;
+        if (ok) {
+            *task = queue.tasks[queue.head % QUEUE_CAPACITY];
+            __atomic_store_n(&queue.head, queue.head + 1, __ATOMIC_RELAXED);
+        }
+        pthread_mutex_unlock(&queue.lock);
+        if (ok) return true;
+    }
+    return false;
+}
+
+/**
+ * @brief Split task down to grain, publishing the upper halves, then run it
+ */
+void execute(size_t self, Task task) {
+    Job* job = task.job;
+    while (task.end - task.begin > job->grain) {
+        size_t mid = task.begin + (task.end - task.begin) / 2;
+        Task upper = { job, mid, task.end };
+        if (!push(self, upper)) break;
+        task.end = mid;
+    }
+
+    in_task = true;
+    job->fn(job->context, task.begin, task.end);
+    in_task = false;
+
+    // Last access to job: the dispatcher may return once this reaches 0
+    __atomic_sub_fetch(&job->remaining, task.end - task.begin, __ATOMIC_RELEASE);
+}
+
+void* workerMain(void* arg) {
+    slot = (size_t)arg;
+    unsigned long seen = 0;
+
+    for (;;) {
+        pthread_mutex_lock(&wake_lock);
+        while (generation == seen) pthread_cond_wait(&wake_cond, &wake_lock);
+        seen = generation;
+        pthread_mutex_unlock(&wake_lock);
+
+        for (;;) {
+            Task task;
+            if (pop(slot, &task) || steal(slot, &task)) {
+                execute(slot, task);
+                continue;
+            }
+            if (!__atomic_load_n(&job_active, __ATOMIC_ACQUIRE)) break;
+            sched_yield();
+        }
+    }
+    return nullptr;
+}
+
+void startPool() {
+    long cores = sysconf(_SC_NPROCESSORS_ONLN);
+    size_t wanted = cores > 0 ? (size_t)cores : 1;
+    if (wanted > MAX_THREADS) wanted = MAX_THREADS;
+
+    for (size_t i = 0; i < wanted; i++) {
+        pthread_mutex_init(&queues[i].lock, nullptr);
+        queues[i].head = 0;
+        queues[i].tail = 0;
+    }
+
+    pthread_attr_t attr;
+    pthread_attr_init(&attr);
+    pthread_attr_setdetachstate(&attr, PTHREAD_CREATE_DETACHED);
+
+    // Worker i serves queue i; queue 0 is the dispatching thread's
+    thread_count = 1;
+    for (size_t i = 1; i < wanted; i++) {
+        pthread_t thread;
+        if (pthread_create(&thread, &attr, workerMain, (void*)i) != 0) break;
+        thread_count++;
+    }
+    pthread_attr_destroy(&attr);
+}
+
+} // namespace
+
+// ===== PUBLIC API =====
+
+size_t concurrency() {
+    pthread_once(&init_once, startPool);
+    return thread_count;
+}
+
+void forRange(size_t count, size_t grain, RangeFn fn, void* context) {
+    if (count == 0 || !fn) return;
+
+    size_t threads = concurrency();
+    if (grain == 0) {
+        // About 8 pieces per thread leaves room to rebalance by stealing
+        grain = count / (threads * 8);
+        if (grain == 0) grain = 1;
+    }
+
+    // Nested, single-threaded or single-piece: no point waking the pool
+    if (in_task || threads == 1 || count <= grain) {
+        fn(context, 0, count);
+        return;
+    }
+
+    pthread_mutex_lock(&dispatch_lock);
+
+    Job job = { fn, context, grain, count };
+    Task root = { &job, 0, count };
+    push(0, root);
+
+    __atomic_store_n(&job_active, 1, __ATOMIC_RELEASE);
+    pthread_mutex_lock(&wake_lock);
+    generation++;
+    pthread_cond_broadcast(&wake_cond);
+    pthread_mutex_unlock(&wake_lock);
+
+    while (__atomic_load_n(&job.remaining, __ATOMIC_ACQUIRE) != 0) {
+        Task task;
+        if (pop(0, &task) || steal(0, &task)) {
+            execute(0, task);
+        } else {
+            sched_yield();
+        }
+    }
+
+    __atomic_store_n(&job_active, 0, __ATOMIC_RELEASE);
+    pthread_mutex_unlock(&dispatch_lock);
+}
+
+} // namespace Parallel
+} // namespace Luna
@@ -0,0 +1,36 @@
+#pragma once
+
+#include "memory.hpp"
+
+namespace Luna {
+namespace Parallel {
+
+/**
+ * @brief Body of a parallel loop: process indices [begin, end)
+ */
+typedef void (*RangeFn)(void* context, size_t begin, size_t end);
+
+/**
+ * @brief Chunk size used by parallel reductions when no grain is given
+ *
+ * Reductions split on fixed chunk boundaries so the combine order, and
+ * therefore a floating-point result, never depends on the thread count.
+ */
+const size_t DEFAULT_REDUCE_GRAIN = 4096;
+
+/**
+ * @brief Threads that run parallel work (pool workers plus the caller)
+ */
+size_t concurrency();
+
+/**
+ * @brief Run fn over [0, count) on the work-stealing pool and wait for it
+ *
+ * Ranges are split in halves until they are at most grain long; idle
+ * threads steal the oldest (largest) halves. grain 0 picks one from count
+ * and the pool size. Calls made from inside a running task run inline.
+ */
+void forRange(size_t count, size_t grain, RangeFn fn, void* context);
+
+} // namespace Parallel
+} // namespace Luna
@@ -0,0 +1,478 @@
+#include "search.hpp"
+#include "cpu.hpp"
+#include <immintrin.h>
+
+namespace Luna {
+
+namespace {
+
+// ===== BYTE ACCESS =====
+// Two-Way runs forwards for find() and over the reversed needle and
+// haystack for findLast(); a view maps logical to physical positions.
+
+struct ForwardView {
+    const unsigned char* bytes;
+    size_t length;
+    unsigned char operator[](size_t i) const { return bytes[i]; }
+};
+
+struct ReverseView {
+    const unsigned char* bytes;
+    size_t length;
+    unsigned char operator[](size_t i) const { return bytes[length - 1 - i]; }
+};
+
+// ===== TWO-WAY =====
+
+/**
+ * @brief Critical factorization: the later of the maximal suffixes under
+ *        both byte orders, with the period of that suffix
+ */
+template<typename View>
+Searcher::Factorization factorize(View needle) {
+    size_t m = needle.length;
+    size_t max_suffix = Searcher::npos;
+    size_t j = 0, k = 1, p = 1;
+    while (j + k < m) {
+        unsigned char a = needle[j + k];
+        unsigned char b = needle[max_suffix + k];
+        if (a < b) {
+            j += k;
+            k = 1;
+            p = j - max_suffix;
+        } else if (a == b) {
+            if (k != p) {
+                k++;
+            } else {
+                j += p;
+                k = 1;
+            }
+        } else {
+            max_suffix = j++;
+            k = p = 1;
+        }
+    }
+    size_t period = p;
+
+    size_t max_suffix_rev = Searcher::npos;
+    j = 0;
+    k = p = 1;
+    while (j + k < m) {
+        unsigned char a = needle[j + k];
+        unsigned char b = needle[max_suffix_rev + k];
+        if (b < a) {
+            j += k;
+            k = 1;
+            p = j - max_suffix_rev;
+        } else if (a == b) {
+            if (k != p) {
+                k++;
+            } else {
+                j += p;
+                k = 1;
+            }
+        } else {
+            max_suffix_rev = j++;
+            k = p = 1;
+        }
+    }
+
+    Searcher::Factorization result;
+    // npos + 1 wraps to 0, the empty-suffix case
+    if (max_suffix_rev + 1 < max_suffix + 1) {
+        result.suffix = max_suffix + 1;
+        result.period = period;
+    } else {
+        result.suffix = max_suffix_rev + 1;
+        result.period = p;
+    }
+
+    // Periodic when the part left of the cut repeats one period later
+    result.periodic = result.suffix + result.period <= m;
+    for (size_t i = 0; result.periodic && i < result.suffix; i++) {
+        if (needle[i] != needle[i + result.period]) result.periodic = false;
+    }
+    if (!result.periodic) {
+        size_t right = m - result.suffix;
+        result.period = (result.suffix > right ? result.suffix : right) + 1;
+    }
+    return result;
+}
+
+/**
+ * @brief First window at or after from where needle matches, or npos
+ */
+template<typename View>
+size_t twoWay(View needle, View haystack, size_t from, const Searcher::Factorization& plan) {
+    size_t m = needle.length;
+    size_t n = haystack.length;
+    size_t suffix = plan.suffix;
+    size_t j = from;
+
+    if (plan.periodic) {
+        // memory: bytes of the window's prefix already known to match
+        size_t memory = 0;
+        while (j + m <= n) {
+            size_t i = suffix > memory ? suffix : memory;
+            while (i < m && needle[i] == haystack[i + j]) i++;
+            if (i >= m) {
+                i = suffix;
+                while (i > memory && needle[i - 1] == haystack[i - 1 + j]) i--;
+                if (i <= memory) return j;
+                j += plan.period;
+                memory = m - plan.period;
+            } else {
+                j += i - suffix + 1;
+                memory = 0;
+            }
+        }
+    } else {
+        while (j + m <= n) {
+            size_t i = suffix;
+            while (i < m && needle[i] == haystack[i + j]) i++;
+            if (i >= m) {
+                i = suffix;
+                while (i > 0 && needle[i - 1] == haystack[i - 1 + j]) i--;
+                if (i == 0) return j;
+                j += plan.period;
+            } else {
+                j += i - suffix + 1;
+            }
+        }
+    }
+    return Searcher::npos;
+}
+
+// ===== SIMD BYTE SCAN =====
+// One-byte needles need no verification: each set bit of the compare mask
+// is a match, the lowest for a forward scan and the highest for a backward one.
+
+__attribute__((target("avx2")))
+size_t firstByteAvx2(const char* data, size_t length, char ch, size_t* stopped) {
+    __m256i wanted = _mm256_set1_epi8(ch);
+    size_t i = 0;
+    for (; i + 32 <= length; i += 32) {
+        __m256i v = _mm256_loadu_si256((const __m256i*)(data + i));
+        unsigned int mask = (unsigned int)_mm256_movemask_epi8(_mm256_cmpeq_epi8(v, wanted));
+        if (mask) return i + (size_t)__builtin_ctz(mask);
+    }
+    *stopped = i;
+    return Searcher::npos;
+}
+
+__attribute__((target("avx2")))
+size_t lastByteAvx2(const char* data, size_t end, char ch, size_t* stopped) {
+    __m256i wanted = _mm256_set1_epi8(ch);
+    size_t i = end;
+    for (; i >= 32; i -= 32) {
+        __m256i v = _mm256_loadu_si256((const __m256i*)(data + i - 32));
+        unsigned int mask = (unsigned int)_mm256_movemask_epi8(_mm256_cmpeq_epi8(v, wanted));
+        if (mask) return i - 1 - (size_t)__builtin_clz(mask);
+    }
+    *stopped = i;
+    return Searcher::npos;
+}
+
+// ===== SIMD FIRST/LAST-BYTE FILTER =====
+// A window can only match if both its first and last bytes do; comparing
+// 16 or 32 windows at once leaves few candidates to verify in full.
+
+inline bool sameBytes(const char* a, const char* b, size_t n) {
+    for (size_t i = 0; i < n; i++) {
+        if (a[i] != b[i]) return false;
+    }
+    return true;
+}
+
+__attribute__((target("avx2")))
+size_t filterForwardAvx2(const char* hay, size_t n, const char* needle, size_t m, size_t from, size_t* stopped) {
+    __m256i first = _mm256_set1_epi8(needle[0]);
+    __m256i last = _mm256_set1_epi8(needle[m - 1]);
+    size_t i = from;
+    for (; i + m - 1 + 32 <= n; i += 32) {
+        __m256i head = _mm256_loadu_si256((const __m256i*)(hay + i));
+        __m256i tail = _mm256_loadu_si256((const __m256i*)(hay + i + m - 1));
+        unsigned int mask = (unsigned int)_mm256_movemask_epi8(
+            _mm256_and_si256(_mm256_cmpeq_epi8(head, first), _mm256_cmpeq_epi8(tail, last)));
+        while (mask) {
+            size_t at = i + (size_t)__builtin_ctz(mask);
+            if (sameBytes(hay + at + 1, needle + 1, m - 2)) return at;
+            mask &= mask - 1;
+        }
+    }
+    *stopped = i;
+    return Searcher::npos;
+}
+
+size_t filterForward(const char* hay, size_t n, const char* needle, size_t m, size_t from) {
+    size_t i = from;
+    if (Cpu::hasAvx2()) {
+        size_t found = filterForwardAvx2(hay, n, needle, m, from, &i);
+        if (found != Searcher::npos) return found;
+    }
+
+    __m128i first = _mm_set1_epi8(needle[0]);
+    __m128i last = _mm_set1_epi8(needle[m - 1]);
+    for (; i + m - 1 + 16 <= n; i += 16) {
+        __m128i head = _mm_loadu_si128((const __m128i*)(hay + i));
+        __m128i tail = _mm_loadu_si128((const __m128i*)(hay + i + m - 1));
+        unsigned int mask = (unsigned int)_mm_movemask_epi8(
+            _mm_and_si128(_mm_cmpeq_epi8(head, first), _mm_cmpeq_epi8(tail, last)));
+        while (mask) {
+            size_t at = i + (size_t)__builtin_ctz(mask);
+            if (sameBytes(hay + at + 1, needle + 1, m - 2)) return at;
+            mask &= mask - 1;
+        }
+    }
+
+    for (; i + m <= n; i++) {
+        if (hay[i] == needle[0] && hay[i + m - 1] == needle[m - 1] && sameBytes(hay + i + 1, needle + 1, m - 2)) {
+            return i;
+        }
+    }
+    return Searcher::npos;
+}
+
+/**
+ * @brief Last window starting below end (exclusive), scanning down
+ */
+size_t filterBackward(const char* hay, const char* needle, size_t m, size_t end) {
+    __m128i first = _mm_set1_epi8(needle[0]);
+    __m128i last = _mm_set1_epi8(needle[m - 1]);
+    size_t i = end;
+    for (; i >= 16; i -= 16) {
+        size_t base = i - 16;
+        __m128i head = _mm_loadu_si128((const __m128i*)(hay + base));
+        __m128i tail = _mm_loadu_si128((const __m128i*)(hay + base + m - 1));
+        unsigned int mask = (unsigned int)_mm_movemask_epi8(
+            _mm_and_si128(_mm_cmpeq_epi8(head, first), _mm_cmpeq_epi8(tail, last)));
+        while (mask) {
+            unsigned int bit = 31 - (unsigned int)__builtin_clz(mask);
+            if (sameBytes(hay + base + bit + 1, needle + 1, m - 2)) return base + bit;
+            mask &= ~(1u << bit);
+        }
+    }
+
+    while (i > 0) {
+        i--;
+        if (hay[i] == needle[0] && hay[i + m - 1] == needle[m - 1] && sameBytes(hay + i + 1, needle + 1, m - 2)) {
+            return i;
+        }
+    }
+    return Searcher::npos;
+}
+
+} // namespace
+
+// ===== SEARCHER =====
+
+Searcher::Searcher(const char* needle_bytes, size_t needle_length)
+    : needle(needle_bytes), length(needle_length) {
+    forward.suffix = backward.suffix = 0;
+    forward.period = backward.period = 1;
+    forward.periodic = backward.periodic = false;
+    if (length > SHORT_NEEDLE) {
+        forward = factorize(ForwardView{ (const unsigned char*)needle, length });
+        backward = factorize(ReverseView{ (const unsigned char*)needle, length });
+    }
+}
+
+size_t Searcher::find(const char* haystack, size_t haystack_length, size_t from) const {
+    if (from > haystack_length || length > haystack_length - from) return npos;
+    if (length == 0) return from;
+
+    if (length == 1) {
+        size_t found = findByte(haystack + from, haystack_length - from, needle[0]);
+        return found == npos ? npos : from + found;
+    }
+    if (length <= SHORT_NEEDLE) return filterForward(haystack, haystack_length, needle, length, from);
+
+    return twoWay(ForwardView{ (const unsigned char*)needle, length },
+                  ForwardView{ (const unsigned char*)haystack, haystack_length }, from, forward);
+}
+
+size_t Searcher::findLast(const char* haystack, size_t haystack_length, size_t before) const {
+    if (length > haystack_length) return npos;
+    size_t last_start = haystack_length - length;
+    if (before > last_start) before = last_start;
+    if (length == 0) return before;
+
+    if (length <= SHORT_NEEDLE) {
+        if (length == 1) return findLastByte(haystack, before + 1, needle[0]);
+        return filterBackward(haystack, needle, length, before + 1);
+    }
+
+    // The last match at or before `before` is the first match of the
+    // reversed needle in the reversed prefix that ends where it would
+    size_t prefix = before + length;
+    size_t found = twoWay(ReverseView{ (const unsigned char*)needle, length },
+                          ReverseView{ (const unsigned char*)haystack, prefix }, 0, backward);
+    return found == npos ? npos : prefix - found - length;
+}
+
+size_t Searcher::findByte(const char* data, size_t length, char ch) {
+    size_t i = 0;
+    if (Cpu::hasAvx2()) {
+        size_t found = firstByteAvx2(data, length, ch, &i);
+        if (found != npos) return found;
+    }
+
+    __m128i wanted = _mm_set1_epi8(ch);
+    for (; i + 16 <= length; i += 16) {
+        __m128i v = _mm_loadu_si128((const __m128i*)(data + i));
+        unsigned int mask = (unsigned int)_mm_movemask_epi8(_mm_cmpeq_epi8(v, wanted));
+        if (mask) return i + (size_t)__builtin_ctz(mask);
+    }
+
+    for (; i < length; i++) {
+        if (data[i] == ch) return i;
+    }
+    return npos;
+}
+
+size_t Searcher::findLastByte(const char* data, size_t length, char ch) {
+    size_t i = length;
+    if (Cpu::hasAvx2()) {
+        size_t found = lastByteAvx2(data, length, ch, &i);
+        if (found != npos) return found;
+    }
+
+    __m128i wanted = _mm_set1_epi8(ch);
+    for (; i >= 16; i -= 16) {
+        __m128i v = _mm_loadu_si128((const __m128i*)(data + i - 16));
+        unsigned int mask = (unsigned int)_mm_movemask_epi8(_mm_cmpeq_epi8(v, wanted));
+        if (mask) return i + 15 - (size_t)__builtin_clz(mask);
+    }
+
+    for (; i > 0; i--) {
+        if (data[i - 1] == ch) return i - 1;
+    }
+    return npos;
+}
+
+size_t Searcher::count(const char* haystack, size_t haystack_length) const {
+    if (length == 0) return haystack_length + 1;
+
+    size_t matches = 0;
+    size_t at = find(haystack, haystack_length, 0);
+    while (at != npos) {
+        matches++;
+        at = find(haystack, haystack_length, at + length);
+    }
+    return matches;
+}
+
+// ===== AHO-CORASICK =====
+
+MultiSearcher::MultiSearcher(const char* const* patterns, const size_t* lengths, size_t count)
+    : class_count(1), state_count(1), pattern_count(count) {
+    // Class 0 is every byte no pattern uses; it always leads back to the root
+    Memory::set(byte_class, 0, sizeof(byte_class));
+    size_t total = 0;
+    for (size_t p = 0; p < count; p++) {
+        for (size_t i = 0; i < lengths[p]; i++) {
+            unsigned char byte = (unsigned char)patterns[p][i];
+            if (!byte_class[byte]) byte_class[byte] = (uint16_t)class_count++;
+        }
+        total += lengths[p];
+    }
+
+    // The trie has at most one state per pattern byte, plus the root
+    const uint32_t NONE = (uint32_t)-1;
+    size_t max_states = total + 1;
+    transitions = (uint32_t*)Memory::allocate(max_states * class_count * sizeof(uint32_t));
+    depth = (uint32_t*)Memory::allocate(max_states * sizeof(uint32_t));
+    match_length = (uint32_t*)Memory::allocate(max_states * sizeof(uint32_t));
+    match_pattern = (uint32_t*)Memory::allocate(max_states * sizeof(uint32_t));
+    Memory::set(transitions, 0xFF, class_count * sizeof(uint32_t));
+    depth[0] = 0;
+    match_length[0] = 0;
+    match_pattern[0] = 0;
+
+    for (size_t p = 0; p < count; p++) {
+        if (lengths[p] == 0) continue;
+        uint32_t state = 0;
+        for (size_t i = 0; i < lengths[p]; i++) {
+            uint32_t* slot = &transitions[state * class_count + byte_class[(unsigned char)patterns[p][i]]];
+            if (*slot == NONE) {
+                uint32_t created = (uint32_t)state_count++;
+                Memory::set(&transitions[created * class_count], 0xFF, class_count * sizeof(uint32_t));
+                depth[created] = depth[state] + 1;
+                match_length[created] = 0;
+                match_pattern[created] = 0;
+                *slot = created;
+            }
+            state = *slot;
+        }
+        if (!match_length[state]) {
+            match_length[state] = (uint32_t)lengths[p];
+            match_pattern[state] = (uint32_t)p;
+        }
+    }
+
+    // Breadth-first, every state's failure state is finished before its
+    // children need it; missing edges borrow the failure state's edges
+    uint32_t* fail = (uint32_t*)Memory::allocate(state_count * sizeof(uint32_t));
+    uint32_t* queue = (uint32_t*)Memory::allocate(state_count * sizeof(uint32_t));
+    size_t head = 0, tail = 0;
+    for (size_t c = 0; c < class_count; c++) {
+        uint32_t& next = transitions[c];
+        if (next == NONE) {
+            next = 0;
+        } else {
+            fail[next] = 0;
+            queue[tail++] = next;
+        }
+    }
+    while (head < tail) {
+        uint32_t state = queue[head++];
+        // A shorter pattern can end where this state's prefix does
+        if (!match_length[state]) {
+            match_length[state] = match_length[fail[state]];
+            match_pattern[state] = match_pattern[fail[state]];
+        }
+        for (size_t c = 0; c < class_count; c++) {
+            uint32_t& next = transitions[state * class_count + c];
+            uint32_t fallback = transitions[fail[state] * class_count + c];
+            if (next == NONE) {
+                next = fallback;
+            } else {
+                fail[next] = fallback;
+                queue[tail++] = next;
+            }
+        }
+    }
+    Memory::deallocate(fail);
+    Memory::deallocate(queue);
+}
+
+MultiSearcher::~MultiSearcher() {
+    Memory::deallocate(transitions);
+    Memory::deallocate(depth);
+    Memory::deallocate(match_length);
+    Memory::deallocate(match_pattern);
+}
+
+bool MultiSearcher::find(const char* haystack, size_t haystack_length, size_t from, Match* match) const {
+    bool found = false;
+    uint32_t state = 0;
+    for (size_t i = from; i < haystack_length; i++) {
+        state = transitions[state * class_count + byte_class[(unsigned char)haystack[i]]];
+        size_t length = match_length[state];
+        if (length) {
+            size_t start = i + 1 - length;
+            if (!found || start < match->start || (start == match->start && length > match->length)) {
+                match->start = start;
+                match->length = length;
+                match->pattern = match_pattern[state];
+                found = true;
+            }
+        }
+        // Any later match starts at or after i + 1 - depth: once that is
+        // past the best start, nothing can beat it
+        if (found && match->start < i + 1 - depth[state]) break;
+    }
+    return found;
+}
+
+} // namespace Luna
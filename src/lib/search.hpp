@@ -0,0 +1,135 @@
+#pragma once
+
+#include "memory.hpp"
+
+typedef unsigned short uint16_t;
+typedef unsigned int uint32_t;
+
+namespace Luna {
+
+/**
+ * @brief Precompiled substring searcher over byte ranges
+ *
+ * Needles of up to SHORT_NEEDLE bytes are found with a SIMD filter on
+ * their first and last bytes; longer needles use the Two-Way algorithm
+ * (Crochemore–Perrin), which is linear in the haystack with O(1) extra
+ * space. The needle is not copied and must outlive the searcher.
+ */
+class Searcher {
+public:
+    static const size_t npos = (size_t)-1;
+    static const size_t SHORT_NEEDLE = 16;
+
+    /**
+     * @brief Two-Way factorization of the needle read in one direction
+     */
+    struct Factorization {
+        size_t suffix;  // Critical position
+        size_t period;
+        bool periodic;  // Needle is periodic: remember matched prefix across shifts
+    };
+
+private:
+    const char* needle;
+    size_t length;
+    Factorization forward;
+    Factorization backward; // Of the reversed needle, for findLast
+
+public:
+    /**
+     * @brief Prepare to search for needle[0, needle_length)
+     */
+    Searcher(const char* needle, size_t needle_length);
+
+    /**
+     * @brief Get needle length
+     */
+    size_t getLength() const { return length; }
+
+    /**
+     * @brief First match starting at or after from, or npos
+     */
+    size_t find(const char* haystack, size_t haystack_length, size_t from = 0) const;
+
+    /**
+     * @brief Last match starting at or before before, or npos
+     */
+    size_t findLast(const char* haystack, size_t haystack_length, size_t before = npos) const;
+
+    /**
+     * @brief Number of non-overlapping matches, scanning left to right
+     */
+    size_t count(const char* haystack, size_t haystack_length) const;
+
+    /**
+     * @brief Index of the first ch in data[0, length), or npos
+     */
+    static size_t findByte(const char* data, size_t length, char ch);
+
+    /**
+     * @brief Index of the last ch in data[0, length), or npos
+     */
+    static size_t findLastByte(const char* data, size_t length, char ch);
+};
+
+/**
+ * @brief Precompiled Aho–Corasick automaton over several patterns
+ *
+ * The automaton is a complete DFA over byte classes (bytes that occur in
+ * no pattern share one class), so each haystack byte costs one table
+ * lookup. Matches are leftmost-longest: the earliest starting match wins,
+ * and among those the longest. Patterns are copied into the automaton
+ * and need not outlive it; empty patterns never match.
+ *
+ * Deciding that no longer match follows takes reading up to the longest
+ * pattern's length past a match, and the next search restarts at the
+ * match's end, so repeated searches cost O(n * L) in the worst case for
+ * a haystack of n bytes and a longest pattern of L bytes; O(n) whenever
+ * matches are rare or the patterns are of similar length.
+ */
+class MultiSearcher {
+public:
+    struct Match {
+        size_t start;
+        size_t length;
+        size_t pattern; // Index of the matched pattern
+    };
+
+private:
+    uint16_t byte_class[256]; // 0 for unused bytes, so up to 257 classes
+    size_t class_count;
+    size_t state_count;
+    size_t pattern_count;
+    uint32_t* transitions;   // state * class_count + class -> next state
+    uint32_t* depth;         // Length of the prefix a state stands for
+    uint32_t* match_length;  // Longest pattern ending in this state, or 0
+    uint32_t* match_pattern; // Its index
+
+public:
+    /**
+     * @brief Build the automaton for patterns[i][0, lengths[i]); duplicates keep the first index
+     */
+    MultiSearcher(const char* const* patterns, const size_t* lengths, size_t count);
+
+    /**
+     * @brief Free the automaton
+     */
+    ~MultiSearcher();
+
+    MultiSearcher(const MultiSearcher&) = delete;
+    MultiSearcher& operator=(const MultiSearcher&) = delete;
+
+    /**
+     * @brief Get number of patterns
+     */
+    size_t getPatternCount() const { return pattern_count; }
+
+    /**
+     * @brief Leftmost-longest match starting at or after from, reading at
+     *        most the longest pattern's length past its end
+     * @returns false if there is none
+     */
+    bool find(const char* haystack, size_t haystack_length, size_t from, Match* match) const;
+};
+
+} // namespace Luna
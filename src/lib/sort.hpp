@@ -0,0 +1,413 @@
+#pragma once
+
+#include "memory.hpp"
+
+typedef unsigned int uint32_t;
+typedef unsigned long uint64_t;
+
+namespace Luna {
+namespace Sort {
+
+// Element types must be trivially copyable: the algorithms move values
+// with plain assignment and stage them in raw Memory::allocate buffers.
+
+namespace detail {
+
+const size_t INSERTION_THRESHOLD = 24;
+const size_t NINTHER_THRESHOLD = 128;
+const size_t PARTIAL_INSERTION_LIMIT = 8;
+const size_t MERGE_RUN = 16;
+
+template<typename T>
+inline void swapValues(T& a, T& b) {
+    T temp = a;
+    a = b;
+    b = temp;
+}
+
+template<typename T, typename Less>
+inline void sort2(T* a, T* b, Less& less) {
+    if (less(*b, *a)) swapValues(*a, *b);
+}
+
+template<typename T, typename Less>
+inline void sort3(T* a, T* b, T* c, Less& less) {
+    sort2(a, b, less);
+    sort2(b, c, less);
+    sort2(a, b, less);
+}
+
+/**
+ * @brief Stable insertion sort of [begin, end)
+ */
+template<typename T, typename Less>
+void insertionSort(T* begin, T* end, Less& less) {
+    if (begin == end) return;
+    for (T* cur = begin + 1; cur != end; ++cur) {
+        T* sift = cur;
+        T* sift_1 = cur - 1;
+        if (less(*sift, *sift_1)) {
+            T temp = *sift;
+            do {
+                *sift-- = *sift_1;
+            } while (sift != begin && less(temp, *--sift_1));
+            *sift = temp;
+        }
+    }
+}
+
+/**
+ * @brief Insertion sort that relies on begin[-1] being <= every element
+ */
+template<typename T, typename Less>
+void unguardedInsertionSort(T* begin, T* end, Less& less) {
+    if (begin == end) return;
+    for (T* cur = begin + 1; cur != end; ++cur) {
+        T* sift = cur;
+        T* sift_1 = cur - 1;
+        if (less(*sift, *sift_1)) {
+            T temp = *sift;
+            do {
+                *sift-- = *sift_1;
+            } while (less(temp, *--sift_1));
+            *sift = temp;
+        }
+    }
+}
+
+/**
+ * @brief Insertion sort that gives up after PARTIAL_INSERTION_LIMIT moves
+ * @returns true if the range ended up sorted
+ */
+template<typename T, typename Less>
+bool partialInsertionSort(T* begin, T* end, Less& less) {
+    if (begin == end) return true;
+    size_t moves = 0;
+    for (T* cur = begin + 1; cur != end; ++cur) {
+        T* sift = cur;
+        T* sift_1 = cur - 1;
+        if (less(*sift, *sift_1)) {
+            T temp = *sift;
+            do {
+                *sift-- = *sift_1;
+            } while (sift != begin && less(temp, *--sift_1));
+            *sift = temp;
+            moves += (size_t)(cur - sift);
+        }
+        if (moves > PARTIAL_INSERTION_LIMIT) return false;
+    }
+    return true;
+}
+
+template<typename T, typename Less>
+void siftDown(T* heap, size_t root, size_t count, Less& less) {
+    T value = heap[root];
+    for (;;) {
+        size_t child = 2 * root + 1;
+        if (child >= count) break;
+        if (child + 1 < count && less(heap[child], heap[child + 1])) child++;
+        if (!less(value, heap[child])) break;
+        heap[root] = heap[child];
+        root = child;
+    }
+    heap[root] = value;
+}
+
+/**
+ * @brief Worst-case fallback once partitioning keeps going badly
+ */
+template<typename T, typename Less>
+void heapSort(T* begin, T* end, Less& less) {
+    size_t count = (size_t)(end - begin);
+    for (size_t i = count / 2; i > 0; i--) siftDown(begin, i - 1, count, less);
+    for (size_t i = count; i > 1; i--) {
+        swapValues(begin[0], begin[i - 1]);
+        siftDown(begin, 0, i - 1, less);
+    }
+}
+
+/**
+ * @brief Partition around *begin, equal elements to the right
+ * @param already_partitioned - Set when no swaps were needed
+ * @returns Final pivot position
+ */
+template<typename T, typename Less>
+T* partitionRight(T* begin, T* end, Less& less, bool& already_partitioned) {
+    T pivot = *begin;
+    T* first = begin;
+    T* last = end;
+
+    // Median-of-3 guarantees an element >= pivot at the end
+    while (less(*++first, pivot));
+
+    if (first - 1 == begin) {
+        while (first < last && !less(*--last, pivot));
+    } else {
+        while (!less(*--last, pivot));
+    }
+
+    already_partitioned = first >= last;
+
+    while (first < last) {
+        swapValues(*first, *last);
+        while (less(*++first, pivot));
+        while (!less(*--last, pivot));
+    }
+
+    T* pivot_pos = first - 1;
+    *begin = *pivot_pos;
+    *pivot_pos = pivot;
+    return pivot_pos;
+}
+
+/**
+ * @brief Partition around *begin, equal elements to the left
+ *
+ * Used when the pivot equals the element before the range, so every
+ * element equal to it is already in its final place.
+ */
+template<typename T, typename Less>
+T* partitionLeft(T* begin, T* end, Less& less) {
+    T pivot = *begin;
+    T* first = begin;
+    T* last = end;
+
+    while (less(pivot, *--last));
+
+    if (last + 1 == end) {
+        while (first < last && !less(pivot, *++first));
+    } else {
+        while (!less(pivot, *++first));
+    }
+
+    while (first < last) {
+        swapValues(*first, *last);
+        while (less(pivot, *--last));
+        while (!less(pivot, *++first));
+    }
+
+    T* pivot_pos = last;
+    *begin = *pivot_pos;
+    *pivot_pos = pivot;
+    return pivot_pos;
+}
+
+template<typename T, typename Less>
+void pdqsortLoop(T* begin, T* end, Less& less, int bad_allowed, bool leftmost) {
+    for (;;) {
+        size_t size = (size_t)(end - begin);
+
+        if (size < INSERTION_THRESHOLD) {
+            if (leftmost) {
+                insertionSort(begin, end, less);
+            } else {
+                unguardedInsertionSort(begin, end, less);
+            }
+            return;
+        }
+
+        // Pivot to *begin: median of 3, or Tukey's ninther for large ranges
+        size_t half = size / 2;
+        if (size > NINTHER_THRESHOLD) {
+            sort3(begin, begin + half, end - 1, less);
+            sort3(begin + 1, begin + (half - 1), end - 2, less);
+            sort3(begin + 2, begin + (half + 1), end - 3, less);
+            sort3(begin + (half - 1), begin + half, begin + (half + 1), less);
+            swapValues(*begin, *(begin + half));
+        } else {
+            sort3(begin + half, begin, end - 1, less);
+        }
+
+        // Runs of equal elements: pivot equals predecessor, skip them all
+        if (!leftmost && !less(*(begin - 1), *begin)) {
+            begin = partitionLeft(begin, end, less) + 1;
+            continue;
+        }
+
+        bool already_partitioned;
+        T* pivot_pos = partitionRight(begin, end, less, already_partitioned);
+
+        size_t left_size = (size_t)(pivot_pos - begin);
+        size_t right_size = (size_t)(end - (pivot_pos + 1));
+
+        if (left_size < size / 8 || right_size < size / 8) {
+            // Bad split: after log2(n) of these, switch to heapsort
+            if (--bad_allowed == 0) {
+                heapSort(begin, end, less);
+                return;
+            }
+
+            // Break up patterns that defeat the pivot choice
+            if (left_size >= INSERTION_THRESHOLD) {
+                swapValues(*begin, *(begin + left_size / 4));
+                swapValues(*(pivot_pos - 1), *(pivot_pos - left_size / 4));
+                if (left_size > NINTHER_THRESHOLD) {
+                    swapValues(*(begin + 1), *(begin + (left_size / 4 + 1)));
+                    swapValues(*(begin + 2), *(begin + (left_size / 4 + 2)));
+                    swapValues(*(pivot_pos - 2), *(pivot_pos - (left_size / 4 + 1)));
+                    swapValues(*(pivot_pos - 3), *(pivot_pos - (left_size / 4 + 2)));
+                }
+            }
+            if (right_size >= INSERTION_THRESHOLD) {
+                swapValues(*(pivot_pos + 1), *(pivot_pos + (1 + right_size / 4)));
+                swapValues(*(end - 1), *(end - right_size / 4));
+                if (right_size > NINTHER_THRESHOLD) {
+                    swapValues(*(pivot_pos + 2), *(pivot_pos + (2 + right_size / 4)));
+                    swapValues(*(pivot_pos + 3), *(pivot_pos + (3 + right_size / 4)));
+                    swapValues(*(end - 2), *(end - (1 + right_size / 4)));
+                    swapValues(*(end - 3), *(end - (2 + right_size / 4)));
+                }
+            }
+        } else if (already_partitioned &&
+                   partialInsertionSort(begin, pivot_pos, less) &&
+                   partialInsertionSort(pivot_pos + 1, end, less)) {
+            // Input looked sorted and was: done in linear time
+            return;
+        }
+
+        pdqsortLoop(begin, pivot_pos, less, bad_allowed, leftmost);
+        begin = pivot_pos + 1;
+        leftmost = false;
+    }
+}
+
+template<typename T, typename Less>
+void mergeSortRecursive(T* data, T* buffer, size_t count, Less& less) {
+    if (count <= MERGE_RUN) {
+        insertionSort(data, data + count, less);
+        return;
+    }
+
+    size_t mid = count / 2;
+    mergeSortRecursive(data, buffer, mid, less);
+    mergeSortRecursive(data + mid, buffer, count - mid, less);
+
+    // Halves already in order
+    if (!less(data[mid], data[mid - 1])) return;
+
+    // Merge the staged left half back; ties take the left element
+    Luna::Memory::copy(buffer, data, mid * sizeof(T));
+    size_t left = 0, right = mid, out = 0;
+    while (left < mid && right < count) {
+        if (less(data[right], buffer[left])) {
+            data[out++] = data[right++];
+        } else {
+            data[out++] = buffer[left++];
+        }
+    }
+    while (left < mid) data[out++] = buffer[left++];
+}
+
+} // namespace detail
+
+/**
+ * @brief Pattern-defeating quicksort (unstable, O(n log n) worst case)
+ * @param less - Strict weak ordering: less(a, b) is true if a sorts before b
+ */
+template<typename T, typename Less>
+void pdqsort(T* data, size_t count, Less less) {
+    static_assert(__is_trivially_copyable(T), "Luna::Sort needs trivially copyable elements");
+    if (count < 2) return;
+
+    int bad_allowed = 1;
+    for (size_t n = count; n > 1; n >>= 1) bad_allowed++;
+    detail::pdqsortLoop(data, data + count, less, bad_allowed, true);
+}
+
+/**
+ * @brief Stable merge sort (n / 2 elements of scratch)
+ */
+template<typename T, typename Less>
+void mergeSort(T* data, size_t count, Less less) {
+    static_assert(__is_trivially_copyable(T), "Luna::Sort needs trivially copyable elements");
+    if (count < 2) return;
+
+    T* buffer = (T*)Luna::Memory::allocate((count / 2 + 1) * sizeof(T));
+    detail::mergeSortRecursive(data, buffer, count, less);
+    Luna::Memory::deallocate(buffer);
+}
+
+/**
+ * @brief Stable LSD radix sort of items by unsigned keys, one byte per pass
+ *
+ * Both arrays are permuted together. Passes where every key has the same
+ * byte are skipped, so small key ranges cost fewer than sizeof(Key) passes.
+ */
+template<typename Key, typename T>
+void radixSort(Key* keys, T* items, size_t count) {
+    static_assert(__is_trivially_copyable(T), "Luna::Sort needs trivially copyable elements");
+    if (count < 2) return;
+
+    const size_t passes = sizeof(Key);
+    size_t* histograms = (size_t*)Luna::Memory::allocate(passes * 256 * sizeof(size_t));
+    Luna::Memory::set(histograms, 0, passes * 256 * sizeof(size_t));
+
+    // One read of the keys builds every pass's histogram
+    for (size_t i = 0; i < count; i++) {
+        Key key = keys[i];
+        for (size_t p = 0; p < passes; p++) {
+            histograms[p * 256 + (size_t)((key >> (p * 8)) & 0xFF)]++;
+        }
+    }
+
+    Key* key_scratch = (Key*)Luna::Memory::allocate(count * sizeof(Key));
+    T* item_scratch = (T*)Luna::Memory::allocate(count * sizeof(T));
+    Key* key_src = keys;
+    Key* key_dst = key_scratch;
+    T* item_src = items;
+    T* item_dst = item_scratch;
+
+    for (size_t p = 0; p < passes; p++) {
+        size_t* histogram = histograms + p * 256;
+        size_t shift = p * 8;
+
+        // Every key shares this byte: the pass would be an identity copy
+        if (histogram[(size_t)((key_src[0] >> shift) & 0xFF)] == count) continue;
+
+        size_t offset = 0;
+        for (size_t b = 0; b < 256; b++) {
+            size_t bucket = histogram[b];
+            histogram[b] = offset;
+            offset += bucket;
+        }
+
+        for (size_t i = 0; i < count; i++) {
+            size_t pos = histogram[(size_t)((key_src[i] >> shift) & 0xFF)]++;
+            key_dst[pos] = key_src[i];
+            item_dst[pos] = item_src[i];
+        }
+
+        Key* key_temp = key_src; key_src = key_dst; key_dst = key_temp;
+        T* item_temp = item_src; item_src = item_dst; item_dst = item_temp;
+    }
+
+    if (key_src != keys) {
+        Luna::Memory::copy(keys, key_src, count * sizeof(Key));
+        Luna::Memory::copy(items, item_src, count * sizeof(T));
+    }
+
+    Luna::Memory::deallocate(item_scratch);
+    Luna::Memory::deallocate(key_scratch);
+    Luna::Memory::deallocate(histograms);
+}
+
+/**
+ * @brief Radix key for a signed 32-bit integer (order-preserving)
+ */
+inline uint32_t int32Key(int value) {
+    return (uint32_t)value ^ 0x80000000u;
+}
+
+/**
+ * @brief Radix key for a double: flip all bits of negatives, only the sign
+ *        bit of positives; NaNs are canonicalized to sort last
+ */
+inline uint64_t doubleKey(double value) {
+    union { double d; uint64_t u; } pun;
+    pun.d = value;
+    uint64_t bits = (value != value) ? 0x7FF8000000000000ULL : pun.u;
+    return (bits & 0x8000000000000000ULL) ? ~bits : (bits | 0x8000000000000000ULL);
+}
+
+} // namespace Sort
+} // namespace Luna
@@ -0,0 +1,460 @@
+#include "unicode.hpp"
+#include "cpu.hpp"
+#include <immintrin.h>
+
+namespace Luna {
+namespace Unicode {
+
+// ===== SCALAR HELPERS =====
+
+/**
+ * @brief Length of the well-formed sequence at s, or 0 if malformed
+ */
+static inline size_t sequenceLength(const unsigned char* s, size_t remaining) {
+    unsigned char lead = s[0];
+    if (lead < 0x80) return 1;
+    if (lead < 0xC2) return 0; // Continuation byte or overlong 2-byte lead
+
+    if (lead < 0xE0) {
+        return (remaining >= 2 && (s[1] & 0xC0) == 0x80) ? 2 : 0;
+    }
+
+    if (lead < 0xF0) {
+        if (remaining < 3) return 0;
+        unsigned char lo = (lead == 0xE0) ? 0xA0 : 0x80; // Overlong
+        unsigned char hi = (lead == 0xED) ? 0x9F : 0xBF; // Surrogates
+        if (s[1] < lo || s[1] > hi || (s[2] & 0xC0) != 0x80) return 0;
+        return 3;
+    }
+
+    if (lead < 0xF5) {
+        if (remaining < 4) return 0;
+        unsigned char lo = (lead == 0xF0) ? 0x90 : 0x80; // Overlong
+        unsigned char hi = (lead == 0xF4) ? 0x8F : 0xBF; // Above U+10FFFF
+        if (s[1] < lo || s[1] > hi || (s[2] & 0xC0) != 0x80 || (s[3] & 0xC0) != 0x80) return 0;
+        return 4;
+    }
+
+    return 0;
+}
+
+/**
+ * @brief Decode a sequence already known to be well-formed
+ */
+static inline uint32_t decodeSequence(const unsigned char* s, size_t length) {
+    switch (length) {
+        case 1: return s[0];
+        case 2: return ((uint32_t)(s[0] & 0x1F) << 6) | (s[1] & 0x3F);
+        case 3: return ((uint32_t)(s[0] & 0x0F) << 12) | ((uint32_t)(s[1] & 0x3F) << 6) | (s[2] & 0x3F);
+        default: return ((uint32_t)(s[0] & 0x07) << 18) | ((uint32_t)(s[1] & 0x3F) << 12) |
+                        ((uint32_t)(s[2] & 0x3F) << 6) | (s[3] & 0x3F);
+    }
+}
+
+static bool validateUtf8Scalar(const char* data, size_t length) {
+    const unsigned char* s = (const unsigned char*)data;
+    size_t i = 0;
+
+    while (i < length) {
+        // Skip ASCII 16 bytes at a time
+        while (i + 16 <= length && _mm_movemask_epi8(_mm_loadu_si128((const __m128i*)(s + i))) == 0) {
+            i += 16;
+        }
+        if (i >= length) break;
+
+        size_t n = sequenceLength(s + i, length - i);
+        if (n == 0) return false;
+        i += n;
+    }
+
+    return true;
+}
+
+// ===== AVX2 VALIDATION =====
+// Lookup-table validator (Keiser & Lemire, "Validating UTF-8 In Less Than
+// One Instruction Per Byte"). Three nibble lookups classify every byte pair,
+// and a saturating subtract checks that 3- and 4-byte leads are followed by
+// the right number of continuations.
+
+static const int TOO_SHORT = 1 << 0;      // 11______ 0_______ or 11______ 11______
+static const int TOO_LONG = 1 << 1;       // 0_______ 10______
+static const int OVERLONG_3 = 1 << 2;     // 11100000 100_____
+static const int TOO_LARGE = 1 << 3;      // 11110100 1001____ and above
+static const int SURROGATE = 1 << 4;      // 11101101 101_____
+static const int OVERLONG_2 = 1 << 5;     // 1100000_ 10______
+static const int TOO_LARGE_1000 = 1 << 6; // 11110101 1000____ and above
+static const int OVERLONG_4 = 1 << 6;     // 11110000 1000____
+static const int TWO_CONTS = 1 << 7;      // 10______ 10______
+static const int CARRY = TOO_SHORT | TOO_LONG | TWO_CONTS;
+
+#define LUNA_TABLE16(a, b, c, d, e, f, g, h, i, j, k, l, m, n, o, p) \
+    (char)(a), (char)(b), (char)(c), (char)(d), (char)(e), (char)(f), (char)(g), (char)(h), \
+    (char)(i), (char)(j), (char)(k), (char)(l), (char)(m), (char)(n), (char)(o), (char)(p)
+
+struct Utf8Checker {
+    __m256i error;
+    __m256i prev_input;
+    __m256i prev_incomplete;
+};
+
+__attribute__((target("avx2")))
+static inline __m256i high_nibbles(__m256i v) {
+    return _mm256_and_si256(_mm256_srli_epi16(v, 4), _mm256_set1_epi8(0x0F));
+}
+
+__attribute__((target("avx2")))
+static inline __m256i checkSpecialCases(__m256i input, __m256i prev1) {
+    const __m256i byte_1_high_table = _mm256_setr_epi8(
+        LUNA_TABLE16(TOO_LONG, TOO_LONG, TOO_LONG, TOO_LONG,
+                     TOO_LONG, TOO_LONG, TOO_LONG, TOO_LONG,
+                     TWO_CONTS, TWO_CONTS, TWO_CONTS, TWO_CONTS,
+                     TOO_SHORT | OVERLONG_2,
+                     TOO_SHORT,
+                     TOO_SHORT | OVERLONG_3 | SURROGATE,
+                     TOO_SHORT | TOO_LARGE | TOO_LARGE_1000 | OVERLONG_4),
+        LUNA_TABLE16(TOO_LONG, TOO_LONG, TOO_LONG, TOO_LONG,
+                     TOO_LONG, TOO_LONG, TOO_LONG, TOO_LONG,
+                     TWO_CONTS, TWO_CONTS, TWO_CONTS, TWO_CONTS,
+                     TOO_SHORT | OVERLONG_2,
+                     TOO_SHORT,
+                     TOO_SHORT | OVERLONG_3 | SURROGATE,
+                     TOO_SHORT | TOO_LARGE | TOO_LARGE_1000 | OVERLONG_4));
+
+    const __m256i byte_1_low_table = _mm256_setr_epi8(
+        LUNA_TABLE16(CARRY | OVERLONG_3 | OVERLONG_2 | OVERLONG_4,
+                     CARRY | OVERLONG_2,
+                     CARRY,
+                     CARRY,
+                     CARRY | TOO_LARGE,
+                     CARRY | TOO_LARGE | TOO_LARGE_1000,
+                     CARRY | TOO_LARGE | TOO_LARGE_1000,
+                     CARRY | TOO_LARGE | TOO_LARGE_1000,
+                     CARRY | TOO_LARGE | TOO_LARGE_1000,
+                     CARRY | TOO_LARGE | TOO_LARGE_1000,
+                     CARRY | TOO_LARGE | TOO_LARGE_1000,
+                     CARRY | TOO_LARGE | TOO_LARGE_1000,
+                     CARRY | TOO_LARGE | TOO_LARGE_1000,
+                     CARRY | TOO_LARGE | TOO_LARGE_1000 | SURROGATE,
+                     CARRY | TOO_LARGE | TOO_LARGE_1000,
+                     CARRY | TOO_LARGE | TOO_LARGE_1000),
+        LUNA_TABLE16(CARRY | OVERLONG_3 | OVERLONG_2 | OVERLONG_4,
+                     CARRY | OVERLONG_2,
+                     CARRY,
+                     CARRY,
+                     CARRY | TOO_LARGE,
+                     CARRY | TOO_LARGE | TOO_LARGE_1000,
+                     CARRY | TOO_LARGE | TOO_LARGE_1000,
+                     CARRY | TOO_LARGE | TOO_LARGE_1000,
+                     CARRY | TOO_LARGE | TOO_LARGE_1000,
+                     CARRY | TOO_LARGE | TOO_LARGE_1000,
+                     CARRY | TOO_LARGE | TOO_LARGE_1000,
+                     CARRY | TOO_LARGE | TOO_LARGE_1000,
+                     CARRY | TOO_LARGE | TOO_LARGE_1000,
+                     CARRY | TOO_LARGE | TOO_LARGE_1000 | SURROGATE,
+                     CARRY | TOO_LARGE | TOO_LARGE_1000,
+                     CARRY | TOO_LARGE | TOO_LARGE_1000));
+
+    const __m256i byte_2_high_table = _mm256_setr_epi8(
+        LUNA_TABLE16(TOO_SHORT, TOO_SHORT, TOO_SHORT, TOO_SHORT,
+                     TOO_SHORT, TOO_SHORT, TOO_SHORT, TOO_SHORT,
+                     TOO_LONG | OVERLONG_2 | TWO_CONTS | OVERLONG_3 | TOO_LARGE_1000 | OVERLONG_4,
+                     TOO_LONG | OVERLONG_2 | TWO_CONTS | OVERLONG_3 | TOO_LARGE,
+                     TOO_LONG | OVERLONG_2 | TWO_CONTS | SURROGATE | TOO_LARGE,
+                     TOO_LONG | OVERLONG_2 | TWO_CONTS | SURROGATE | TOO_LARGE,
+                     TOO_SHORT, TOO_SHORT, TOO_SHORT, TOO_SHORT),
+        LUNA_TABLE16(TOO_SHORT, TOO_SHORT, TOO_SHORT, TOO_SHORT,
+                     TOO_SHORT, TOO_SHORT, TOO_SHORT, TOO_SHORT,
+                     TOO_LONG | OVERLONG_2 | TWO_CONTS | OVERLONG_3 | TOO_LARGE_1000 | OVERLONG_4,
+                     TOO_LONG | OVERLONG_2 | TWO_CONTS | OVERLONG_3 | TOO_LARGE,
+                     TOO_LONG | OVERLONG_2 | TWO_CONTS | SURROGATE | TOO_LARGE,
+                     TOO_LONG | OVERLONG_2 | TWO_CONTS | SURROGATE | TOO_LARGE,
+                     TOO_SHORT, TOO_SHORT, TOO_SHORT, TOO_SHORT));
+
+    __m256i byte_1_high = _mm256_shuffle_epi8(byte_1_high_table, high_nibbles(prev1));
+    __m256i byte_1_low = _mm256_shuffle_epi8(byte_1_low_table, _mm256_and_si256(prev1, _mm256_set1_epi8(0x0F)));
+    __m256i byte_2_high = _mm256_shuffle_epi8(byte_2_high_table, high_nibbles(input));
+    return _mm256_and_si256(_mm256_and_si256(byte_1_high, byte_1_low), byte_2_high);
+}
+
+/**
+ * @brief Bytes of input shifted right by n, pulling in the tail of prev
+ */
+template<int N>
+__attribute__((target("avx2")))
+static inline __m256i previousBytes(__m256i input, __m256i prev) {
+    return _mm256_alignr_epi8(input, _mm256_permute2x128_si256(prev, input, 0x21), 16 - N);
+}
+
+__attribute__((target("avx2")))
+static inline void checkBlock(Utf8Checker& checker, __m256i input) {
+    if (_mm256_movemask_epi8(input) == 0) {
+        // ASCII block: only an unfinished sequence from the last block can fail
+        checker.error = _mm256_or_si256(checker.error, checker.prev_incomplete);
+    } else {
+        __m256i prev1 = previousBytes<1>(input, checker.prev_input);
+        __m256i special = checkSpecialCases(input, prev1);
+
+        __m256i prev2 = previousBytes<2>(input, checker.prev_input);
+        __m256i prev3 = previousBytes<3>(input, checker.prev_input);
+        __m256i is_third = _mm256_subs_epu8(prev2, _mm256_set1_epi8((char)(0xE0 - 0x80)));
+        __m256i is_fourth = _mm256_subs_epu8(prev3, _mm256_set1_epi8((char)(0xF0 - 0x80)));
+        __m256i must_be_cont = _mm256_and_si256(_mm256_or_si256(is_third, is_fourth),
+                                                _mm256_set1_epi8((char)0x80));
+        checker.error = _mm256_or_si256(checker.error, _mm256_xor_si256(must_be_cont, special));
+
+        // A lead byte in the last three positions needs bytes from the next block
+        const __m256i max_value = _mm256_setr_epi8(
+            (char)255, (char)255, (char)255, (char)255, (char)255, (char)255, (char)255, (char)255,
+            (char)255, (char)255, (char)255, (char)255, (char)255, (char)255, (char)255, (char)255,
+            (char)255, (char)255, (char)255, (char)255, (char)255, (char)255, (char)255, (char)255,
+            (char)255, (char)255, (char)255, (char)255, (char)255,
+            (char)(0xF0 - 1), (char)(0xE0 - 1), (char)(0xC0 - 1));
+        checker.prev_incomplete = _mm256_subs_epu8(input, max_value);
+    }
+    checker.prev_input = input;
+}
+
+__attribute__((target("avx2")))
+static bool validateUtf8Avx2(const char* data, size_t length) {
+    Utf8Checker checker;
+    checker.error = _mm256_setzero_si256();
+    checker.prev_input = _mm256_setzero_si256();
+    checker.prev_incomplete = _mm256_setzero_si256();
+
+    size_t i = 0;
+    for (; i + 32 <= length; i += 32) {
+        checkBlock(checker, _mm256_loadu_si256((const __m256i*)(data + i)));
+    }
+
+    if (i < length) {
+        // Zero padding is ASCII, so it completes nothing and breaks nothing
+        char tail[32];
+        Memory::set(tail, 0, 32);
+        Memory::copy(tail, data + i, length - i);
+        checkBlock(checker, _mm256_loadu_si256((const __m256i*)tail));
+    }
+
+    checker.error = _mm256_or_si256(checker.error, checker.prev_incomplete);
+    return _mm256_testz_si256(checker.error, checker.error) != 0;
+}
+
+#undef LUNA_TABLE16
+
+// ===== COUNTING KERNELS =====
+
+__attribute__((target("avx2,popcnt")))
+static size_t countLeadsAvx2(const char* data, size_t length, size_t* processed, size_t* four_byte) {
+    size_t leads = 0;
+    size_t fours = 0;
+    size_t i = 0;
+    const __m256i cont_max = _mm256_set1_epi8((char)0xBF); // -65: continuations are <= this
+    const __m256i four_min = _mm256_set1_epi8((char)0xEF); // -17: 4-byte leads are above this
+
+    for (; i + 32 <= length; i += 32) {
+        __m256i v = _mm256_loadu_si256((const __m256i*)(data + i));
+        unsigned int lead_mask = (unsigned int)_mm256_movemask_epi8(_mm256_cmpgt_epi8(v, cont_max));
+        unsigned int four_mask = (unsigned int)_mm256_movemask_epi8(
+            _mm256_andnot_si256(_mm256_cmpgt_epi8(v, _mm256_set1_epi8(-1)), _mm256_cmpgt_epi8(v, four_min)));
+        leads += (size_t)__builtin_popcount(lead_mask);
+        fours += (size_t)__builtin_popcount(four_mask);
+    }
+
+    *processed = i;
+    *four_byte = fours;
+    return leads;
+}
+
+static size_t countLeadsSse2(const char* data, size_t length, size_t* processed, size_t* four_byte) {
+    size_t leads = 0;
+    size_t fours = 0;
+    size_t i = 0;
+    const __m128i cont_max = _mm_set1_epi8((char)0xBF);
+    const __m128i four_min = _mm_set1_epi8((char)0xEF);
+
+    for (; i + 16 <= length; i += 16) {
+        __m128i v = _mm_loadu_si128((const __m128i*)(data + i));
+        unsigned int lead_mask = (unsigned int)_mm_movemask_epi8(_mm_cmpgt_epi8(v, cont_max));
+        unsigned int four_mask = (unsigned int)_mm_movemask_epi8(
+            _mm_and_si128(_mm_cmplt_epi8(v, _mm_setzero_si128()), _mm_cmpgt_epi8(v, four_min)));
+        leads += (size_t)__builtin_popcount(lead_mask);
+        fours += (size_t)__builtin_popcount(four_mask);
+    }
+
+    *processed = i;
+    *four_byte = fours;
+    return leads;
+}
+
+/**
+ * @brief Count non-continuation bytes and 4-byte lead bytes
+ */
+static size_t countLeads(const char* data, size_t length, size_t* four_byte) {
+    size_t i = 0;
+    size_t fours = 0;
+    size_t leads = Cpu::hasAvx2() ? countLeadsAvx2(data, length, &i, &fours)
+                                  : countLeadsSse2(data, length, &i, &fours);
+
+    for (; i < length; i++) {
+        signed char b = (signed char)data[i];
+        if (b > -65) leads++;
+        if (b >= -16) fours += (b < 0);
+    }
+
+    *four_byte = fours;
+    return leads;
+}
+
+// ===== PUBLIC API =====
+
+bool validateUtf8(const char* data, size_t length) {
+    if (!data || length == 0) return true;
+    if (Cpu::hasAvx2()) return validateUtf8Avx2(data, length);
+    return validateUtf8Scalar(data, length);
+}
+
+size_t countCodePoints(const char* data, size_t length) {
+    if (!data) return 0;
+    size_t four_byte;
+    return countLeads(data, length, &four_byte);
+}
+
+size_t utf16Length(const char* data, size_t length) {
+    if (!data) return 0;
+    size_t four_byte;
+    size_t leads = countLeads(data, length, &four_byte);
+    return leads + four_byte; // Each 4-byte sequence becomes a surrogate pair
+}
+
+size_t utf8Length(const uint16_t* data, size_t length) {
+    if (!data) return 0;
+
+    size_t bytes = 0;
+    size_t i = 0;
+    while (i < length) {
+        // 8 ASCII units at a time
+        if (i + 8 <= length) {
+            __m128i v = _mm_loadu_si128((const __m128i*)(data + i));
+            __m128i high = _mm_and_si128(v, _mm_set1_epi16((short)0xFF80));
+            if (_mm_movemask_epi8(_mm_cmpeq_epi16(high, _mm_setzero_si128())) == 0xFFFF) {
+                bytes += 8;
+                i += 8;
+                continue;
+            }
+        }
+
+        uint16_t unit = data[i];
+        if (unit < 0x80) bytes += 1;
+        else if (unit < 0x800) bytes += 2;
+        else if (unit >= 0xD800 && unit <= 0xDBFF && i + 1 < length &&
+                 data[i + 1] >= 0xDC00 && data[i + 1] <= 0xDFFF) {
+            bytes += 4;
+            i++;
+        } else bytes += 3;
+        i++;
+    }
+
+    return bytes;
+}
+
+size_t utf8ToUtf16(const char* src, size_t length, uint16_t* dest) {
+    if (!src || !dest) return 0;
+
+    const unsigned char* s = (const unsigned char*)src;
+    size_t i = 0;
+    size_t out = 0;
+
+    while (i < length) {
+        // Widen 16 ASCII bytes at a time
+        if (i + 16 <= length) {
+            __m128i v = _mm_loadu_si128((const __m128i*)(s + i));
+            if (_mm_movemask_epi8(v) == 0) {
+                _mm_storeu_si128((__m128i*)(dest + out), _mm_unpacklo_epi8(v, _mm_setzero_si128()));
+                _mm_storeu_si128((__m128i*)(dest + out + 8), _mm_unpackhi_epi8(v, _mm_setzero_si128()));
+                i += 16;
+                out += 16;
+                continue;
+            }
+        }
+
+        size_t n = sequenceLength(s + i, length - i);
+        if (n == 0) return npos;
+
+        uint32_t cp = decodeSequence(s + i, n);
+        if (cp >= 0x10000) {
+            cp -= 0x10000;
+            dest[out++] = (uint16_t)(0xD800 | (cp >> 10));
+            dest[out++] = (uint16_t)(0xDC00 | (cp & 0x3FF));
+        } else {
+            dest[out++] = (uint16_t)cp;
+        }
+        i += n;
+    }
+
+    return out;
+}
+
+size_t utf16ToUtf8(const uint16_t* src, size_t length, char* dest) {
+    if (!src || !dest) return 0;
+
+    unsigned char* d = (unsigned char*)dest;
+    size_t i = 0;
+    size_t out = 0;
+
+    while (i < length) {
+        // Narrow 8 ASCII units at a time
+        if (i + 8 <= length) {
+            __m128i v = _mm_loadu_si128((const __m128i*)(src + i));
+            __m128i high = _mm_and_si128(v, _mm_set1_epi16((short)0xFF80));
+            if (_mm_movemask_epi8(_mm_cmpeq_epi16(high, _mm_setzero_si128())) == 0xFFFF) {
+                _mm_storel_epi64((__m128i*)(d + out), _mm_packus_epi16(v, v));
+                i += 8;
+                out += 8;
+                continue;
+            }
+        }
+
+        uint32_t cp = src[i++];
+        if (cp >= 0xD800 && cp <= 0xDFFF) {
+            if (cp > 0xDBFF || i >= length || src[i] < 0xDC00 || src[i] > 0xDFFF) return npos;
+            cp = 0x10000 + ((cp - 0xD800) << 10) + (src[i++] - 0xDC00);
+        }
+
+        if (cp < 0x80) {
+            d[out++] = (unsigned char)cp;
+        } else if (cp < 0x800) {
+            d[out++] = (unsigned char)(0xC0 | (cp >> 6));
+            d[out++] = (unsigned char)(0x80 | (cp & 0x3F));
+        } else if (cp < 0x10000) {
+            d[out++] = (unsigned char)(0xE0 | (cp >> 12));
+            d[out++] = (unsigned char)(0x80 | ((cp >> 6) & 0x3F));
+            d[out++] = (unsigned char)(0x80 | (cp & 0x3F));
+        } else {
+            d[out++] = (unsigned char)(0xF0 | (cp >> 18));
+            d[out++] = (unsigned char)(0x80 | ((cp >> 12) & 0x3F));
+            d[out++] = (unsigned char)(0x80 | ((cp >> 6) & 0x3F));
+            d[out++] = (unsigned char)(0x80 | (cp & 0x3F));
+        }
+    }
+
+    return out;
+}
+
+uint32_t decode(const char* data, size_t length, size_t* consumed) {
+    if (!data || length == 0) {
+        if (consumed) *consumed = 0;
+        return REPLACEMENT_CHARACTER;
+    }
+
+    const unsigned char* s = (const unsigned char*)data;
+    size_t n = sequenceLength(s, length);
+    if (n == 0) {
+        if (consumed) *consumed = 1;
+        return REPLACEMENT_CHARACTER;
+    }
+
+    if (consumed) *consumed = n;
+    return decodeSequence(s, n);
+}
+
+} // namespace Unicode
+} // namespace Luna
@@ -0,0 +1,64 @@
+#pragma once
+
+#include "memory.hpp"
+
+typedef unsigned short uint16_t;
+typedef unsigned int uint32_t;
+
+namespace Luna {
+namespace Unicode {
+
+/**
+ * @brief Returned by transcoders when the input is malformed
+ */
+const size_t npos = (size_t)-1;
+
+/**
+ * @brief Replacement character produced for malformed sequences
+ */
+const uint32_t REPLACEMENT_CHARACTER = 0xFFFD;
+
+/**
+ * @brief Check that data is well-formed UTF-8
+ *        (no overlongs, surrogates, or code points above U+10FFFF)
+ */
+bool validateUtf8(const char* data, size_t length);
+
+/**
+ * @brief Count code points in valid UTF-8
+ */
+size_t countCodePoints(const char* data, size_t length);
+
+/**
+ * @brief Number of UTF-16 code units needed for valid UTF-8
+ */
+size_t utf16Length(const char* data, size_t length);
+
+/**
+ * @brief Number of UTF-8 bytes needed for valid UTF-16
+ */
+size_t utf8Length(const uint16_t* data, size_t length);
+
+/**
+ * @brief Transcode UTF-8 to UTF-16
+ * @param dest - Buffer of at least utf16Length(src, length) units
+ * @returns Units written, or npos if src is malformed
+ */
+size_t utf8ToUtf16(const char* src, size_t length, uint16_t* dest);
+
+/**
+ * @brief Transcode UTF-16 to UTF-8
+ * @param dest - Buffer of at least utf8Length(src, length) bytes
+ * @returns Bytes written, or npos on an unpaired surrogate
+ */
+size_t utf16ToUtf8(const uint16_t* src, size_t length, char* dest);
+
+/**
+ * @brief Decode one code point starting at data
+ * @param consumed - Receives bytes consumed (1 for a malformed sequence)
+ * @returns Code point, or REPLACEMENT_CHARACTER if malformed
+ */
+uint32_t decode(const char* data, size_t length, size_t* consumed);
+
+} // namespace Unicode
+} // namespace Luna
@@ -1,11 +1,19 @@
 #include "types/Number.hpp"
 #include "types/Boolean.hpp"
+#include "types/BooleanArray.hpp"
 #include "types/Array.hpp"
+#include "types/ArrayOf.hpp"
+#include "types/PersistentVector.hpp"
+#include "types/Deque.hpp"
+#include "types/Map.hpp"
+#include "types/Object.hpp"
 #include "types/Char.hpp"
 #include "lib/memory.hpp"
 #include "lib/console.hpp"
 #include "types/Strings.hpp"
 #include "lib/math.hpp"
+#include "lib/search.hpp"
+#include "lib/parallel.hpp"
 #include <stdio.h>
 #include <setjmp.h>
 #include <signal.h>
@@ -368,6 +376,88 @@ void testBoolean() {
     });
 }
 
+void testBooleanArray() {
+    printLine("\n=== BooleanArray Tests ===");
+    
+    printLine("\n[Basic Operations]");
+    runProtectedTest("BooleanArray construction", []() -> bool {
+        BooleanArray empty;
+        BooleanArray ones(130, true);
+        return empty.isEmpty() && 
+               ones.getLength() == 130 && 
+               ones.get(0) && ones.get(129) && 
+               !ones.get(130);
+    });
+    
+    runProtectedTest("BooleanArray push, get and set", []() -> bool {
+        BooleanArray bits;
+        for (int i = 0; i < 100; i++) {
+            bits.push(i % 3 == 0);
+        }
+        bits.set(1, true);
+        bits.set(3, false);
+        return bits.getLength() == 100 && 
+               bits.get(0) && bits.get(1) && !bits.get(2) && 
+               !bits.get(3) && bits.get(99);
+    });
+    
+    printLine("\n[Logical Operations]");
+    runProtectedTest("BooleanArray AND/OR/XOR", []() -> bool {
+        BooleanArray a(300);
+        BooleanArray b(300);
+        for (size_t i = 0; i < 300; i += 2) a.set(i, true);
+        for (size_t i = 0; i < 300; i += 3) b.set(i, true);
+        
+        BooleanArray and_bits(300);
+        and_bits.logicalOr(a);
+        and_bits.logicalAnd(b);
+        
+        BooleanArray xor_bits(300);
+        xor_bits.logicalOr(a);
+        xor_bits.logicalXor(b);
+        
+        a.logicalOr(b);
+        return and_bits.popcount() == 50 && 
+               a.popcount() == 200 && 
+               xor_bits.popcount() == 150;
+    });
+    
+    runProtectedTest("BooleanArray NOT keeps tail clear", []() -> bool {
+        BooleanArray bits(70);
+        bits.set(5, true);
+        bits.logicalNot();
+        return bits.popcount() == 69 && !bits.get(5) && bits.get(69);
+    });
+    
+    printLine("\n[Search and Iteration]");
+    runProtectedTest("BooleanArray findFirstSet", []() -> bool {
+        BooleanArray bits(1000);
+        bits.set(777, true);
+        bits.set(900, true);
+        return bits.findFirstSet() == 777 && 
+               bits.findFirstSet(778) == 900 && 
+               bits.findFirstSet(901) == BooleanArray::npos;
+    });
+    
+    runProtectedTest("BooleanArray set-bit iteration", []() -> bool {
+        BooleanArray bits(500);
+        bits.set(3, true);
+        bits.set(64, true);
+        bits.set(499, true);
+        
+        size_t sum = 0;
+        size_t count = 0;
+        for (size_t index : bits) {
+            sum += index;
+            count++;
+        }
+        
+        size_t callback_sum = 0;
+        bits.forEachSet([&](size_t index) { callback_sum += index; });
+        return count == 3 && sum == 566 && callback_sum == 566;
+    });
+}
+
 void testMemory() {
     printLine("\n=== Memory Management Tests ===");
     
@@ -422,6 +512,15 @@ void testMemory() {
         return result;
     });
     
+    runProtectedTest("Memory move (overlapping)", []() -> bool {
+        char buffer[32];
+        for (int i = 0; i < 32; i++) buffer[i] = (char)i;
+        Luna::Memory::move(buffer + 3, buffer, 21);  // Backward
+        bool right = buffer[3] == 0 && buffer[23] == 20 && buffer[24] == 24;
+        Luna::Memory::move(buffer, buffer + 3, 21);  // Forward
+        return right && buffer[0] == 0 && buffer[20] == 20;
+    });
+    
     runProtectedTest("Memory deallocation", []() -> bool {
         void* mem = Luna::Memory::allocate(256);
         if (mem) Luna::Memory::deallocate(mem);
@@ -429,6 +528,18 @@ void testMemory() {
     });
 }
 
+// Element type with a non-trivial copy and destructor for ArrayOf tests
+static int tracked_live = 0;
+
+struct Tracked {
+    int value;
+    Tracked(int v) : value(v) { tracked_live++; }
+    Tracked(const Tracked& other) : value(other.value) { tracked_live++; }
+    Tracked& operator=(const Tracked& other) { value = other.value; return *this; }
+    ~Tracked() { tracked_live--; }
+    bool operator==(const Tracked& other) const { return value == other.value; }
+};
+
 void testArray() {
     printLine("\n=== Array Tests ===");
     
@@ -518,7 +629,7 @@ void testArray() {
         arr.push(&value2);
         return arr.indexOf(&value1) == 0 && 
                arr.indexOf(&value2) == 1 && 
-               arr.indexOf(&value3) == -1;
+               arr.indexOf(&value3) == Array::npos;
     });
     
     runProtectedTest("Array contains", []() -> bool {
@@ -542,6 +653,851 @@ void testArray() {
         }
         return arr.getLength() == 10 && arr.getCapacity() >= 10;
     });
+    
+    printLine("\n[Bulk Operations]");
+    runProtectedTest("Array splice", []() -> bool {
+        int values[6] = {0, 1, 2, 3, 4, 5};
+        int extra[2] = {10, 11};
+        void* inserts[2] = {&extra[0], &extra[1]};
+        Array arr;
+        for (int i = 0; i < 6; i++) arr.push(&values[i]);
+        
+        Array* removed = arr.splice(1, 3, inserts, 2);
+        bool result = removed->getLength() == 3 && 
+                      *(int*)removed->get(0) == 1 && 
+                      *(int*)removed->get(2) == 3 && 
+                      arr.getLength() == 5 && 
+                      *(int*)arr.get(0) == 0 && 
+                      *(int*)arr.get(1) == 10 && 
+                      *(int*)arr.get(2) == 11 && 
+                      *(int*)arr.get(3) == 4;
+        delete removed;
+        return result;
+    });
+    
+    runProtectedTest("Array removeRange and insertAll", []() -> bool {
+        int values[10];
+        Array arr;
+        for (int i = 0; i < 10; i++) {
+            values[i] = i;
+            arr.push(&values[i]);
+        }
+        arr.removeRange(2, 5);
+        bool removed = arr.getLength() == 5 && *(int*)arr.get(2) == 7;
+        void* items[2] = {&values[0], &values[1]};
+        arr.insertAll(1, items, 2);
+        return removed && 
+               arr.getLength() == 7 && 
+               *(int*)arr.get(1) == 0 && 
+               *(int*)arr.get(2) == 1 && 
+               *(int*)arr.get(3) == 1;
+    });
+    
+    runProtectedTest("Array slice and concat", []() -> bool {
+        int values[5] = {0, 1, 2, 3, 4};
+        Array arr;
+        for (int i = 0; i < 5; i++) arr.push(&values[i]);
+        
+        Array* middle = arr.slice(1, 4);
+        Array* tail = arr.slice(3);
+        Array* joined = middle->concat(*tail);
+        bool result = middle->getLength() == 3 && 
+                      tail->getLength() == 2 && 
+                      joined->getLength() == 5 && 
+                      *(int*)joined->get(0) == 1 && 
+                      *(int*)joined->get(3) == 3 && 
+                      *(int*)joined->get(4) == 4;
+        delete middle;
+        delete tail;
+        delete joined;
+        return result;
+    });
+    
+    runProtectedTest("Array fill, copyWithin and reverse", []() -> bool {
+        int values[5] = {0, 1, 2, 3, 4};
+        int marker = 99;
+        Array arr;
+        for (int i = 0; i < 5; i++) arr.push(&values[i]);
+        
+        arr.copyWithin(0, 3);       // [3, 4, 2, 3, 4]
+        bool copied = *(int*)arr.get(0) == 3 && *(int*)arr.get(1) == 4 && *(int*)arr.get(2) == 2;
+        arr.fill(&marker, 3);       // [3, 4, 2, 99, 99]
+        arr.reverse();              // [99, 99, 2, 4, 3]
+        return copied && 
+               *(int*)arr.get(0) == 99 && 
+               *(int*)arr.get(1) == 99 && 
+               *(int*)arr.get(2) == 2 && 
+               *(int*)arr.get(4) == 3;
+    });
+    
+    printLine("\n[Capacity Management]");
+    runProtectedTest("Array reserve and shrinkToFit", []() -> bool {
+        Array arr;
+        arr.reserve(1000);
+        bool reserved = arr.getCapacity() == 1000;
+        int value = 7;
+        arr.push(&value);
+        arr.push(&value);
+        arr.shrinkToFit();
+        return reserved && 
+               arr.getCapacity() == 2 && 
+               arr.getLength() == 2 && 
+               *(int*)arr.get(1) == 7;
+    });
+    
+    runProtectedTest("Array resize", []() -> bool {
+        Array arr(2);
+        int value = 5;
+        arr.push(&value);
+        arr.resize(20);
+        bool grown = arr.getLength() == 20 && arr.get(0) == &value && arr.get(19) == nullptr;
+        arr.resize(1);
+        return grown && arr.getLength() == 1 && arr.get(1) == nullptr;
+    });
+    
+    runProtectedTest("Array pushAll and extend", []() -> bool {
+        int values[100];
+        void* items[100];
+        for (int i = 0; i < 100; i++) {
+            values[i] = i;
+            items[i] = &values[i];
+        }
+        
+        Array arr(4);
+        arr.pushAll(items, 100);
+        Array other;
+        other.extend(arr);
+        arr.extend(arr); // Self-extend while growing
+        return other.getLength() == 100 && 
+               *(int*)other.get(99) == 99 && 
+               arr.getLength() == 200 && 
+               *(int*)arr.get(150) == 50;
+    });
+    
+    printLine("\n[Search]");
+    runProtectedTest("Array indexOf at every position", []() -> bool {
+        int values[67];
+        Array arr;
+        for (int i = 0; i < 67; i++) arr.push(&values[i]);
+        for (size_t i = 0; i < 67; i++) {
+            if (arr.indexOf(&values[i]) != i) return false;
+        }
+        int missing = 0;
+        arr.push(&values[3]); // Duplicate: first match wins
+        return arr.indexOf(&missing) == Array::npos && arr.indexOf(&values[3]) == 3;
+    });
+    
+    runProtectedTest("Array hash index tracks mutations", []() -> bool {
+        int values[200];
+        Array arr;
+        for (int i = 0; i < 100; i++) arr.push(&values[i]);
+        arr.enableIndex();
+        for (int i = 100; i < 200; i++) arr.push(&values[i]);
+        arr.push(&values[5]);
+        
+        bool ok = arr.contains(&values[150]) && arr.indexOf(&values[199]) == 199;
+        arr.remove(5);
+        ok = ok && arr.contains(&values[5]); // Duplicate still present
+        arr.pop();
+        ok = ok && !arr.contains(&values[5]);
+        arr.removeRange(0, 50);
+        arr.set(0, &values[0]);
+        ok = ok && !arr.contains(&values[10]) && !arr.contains(&values[51]) && arr.contains(&values[0]);
+        arr.clear();
+        return ok && !arr.contains(&values[0]) && arr.hasIndex();
+    });
+    
+    printLine("\n[Sorting]");
+    runProtectedTest("Array sort with comparator", []() -> bool {
+        int values[500];
+        Array arr;
+        for (int i = 0; i < 500; i++) {
+            values[i] = (i * 7919) % 500;
+            arr.push(&values[i]);
+        }
+        arr.sort([](void* a, void* b) -> int { return *(int*)a - *(int*)b; });
+        for (int i = 0; i < 500; i++) {
+            if (*(int*)arr.get(i) != i) return false;
+        }
+        return true;
+    });
+    
+    runProtectedTest("Array stable sort keeps equal order", []() -> bool {
+        int values[300];
+        Array arr;
+        for (int i = 0; i < 300; i++) {
+            values[i] = i;
+            arr.push(&values[i]);
+        }
+        // Order by value mod 3; ties must stay in original (ascending) order
+        arr.sort([](void* a, void* b) -> int { return *(int*)a % 3 - *(int*)b % 3; }, true);
+        for (int i = 1; i < 300; i++) {
+            int prev = *(int*)arr.get(i - 1);
+            int cur = *(int*)arr.get(i);
+            if (prev % 3 == cur % 3 && prev > cur) return false;
+        }
+        return *(int*)arr.get(0) == 0 && *(int*)arr.get(100) == 1;
+    });
+    
+    runProtectedTest("Array sortNumbers (radix)", []() -> bool {
+        Number values[] = {Number(3), Number(-2.5), Number::nan(), Number(-7), Number(0), Number(1e10), Number(-1e10)};
+        Array arr;
+        for (int i = 0; i < 7; i++) arr.push(&values[i]);
+        arr.sortNumbers();
+        bool mixed = ((Number*)arr.get(0))->equals(Number(-1e10)) &&
+                     ((Number*)arr.get(1))->equals(Number(-7)) &&
+                     ((Number*)arr.get(3))->equals(Number(0)) &&
+                     ((Number*)arr.get(5))->equals(Number(1e10)) &&
+                     ((Number*)arr.get(6))->isNaN();
+        
+        Number ints[] = {Number(5), Number(-1), Number(2147483647), Number(-2147483647 - 1)};
+        Array int_arr;
+        for (int i = 0; i < 4; i++) int_arr.push(&ints[i]);
+        int_arr.sortNumbers();
+        return mixed &&
+               ((Number*)int_arr.get(0))->toInt() == -2147483647 - 1 &&
+               ((Number*)int_arr.get(3))->toInt() == 2147483647;
+    });
+    
+    runProtectedTest("Array sortStrings (multikey)", []() -> bool {
+        const char* words[] = {"pear", "apple", "app", "", "banana", "apple", "applesauce", "b"};
+        Luna::std::string strings[8];
+        Array arr;
+        for (int i = 0; i < 8; i++) {
+            strings[i] = Luna::std::string(words[i]);
+            arr.push(&strings[i]);
+        }
+        arr.sortStrings();
+        const char* expected[] = {"", "app", "apple", "apple", "applesauce", "b", "banana", "pear"};
+        for (int i = 0; i < 8; i++) {
+            if (!(*(Luna::std::string*)arr.get(i) == Luna::std::string(expected[i]))) return false;
+        }
+        return true;
+    });
+    
+    printLine("\n[Iteration]");
+    runProtectedTest("Array forEach, map and filter", []() -> bool {
+        int values[10];
+        Array arr;
+        for (int i = 0; i < 10; i++) {
+            values[i] = i;
+            arr.push(&values[i]);
+        }
+        int sum = 0;
+        arr.forEach([&](void* value, size_t) { sum += *(int*)value; });
+        
+        // Map to the element one further along (last wraps to first)
+        Array* shifted = arr.map([&](void*, size_t index) -> void* { return arr.get((index + 1) % 10); });
+        Array* evens = arr.filter([](void* value, size_t) { return *(int*)value % 2 == 0; });
+        bool ok = sum == 45 &&
+                  shifted->getLength() == 10 && *(int*)shifted->get(9) == 0 &&
+                  evens->getLength() == 5 && *(int*)evens->get(4) == 8;
+        delete shifted;
+        delete evens;
+        return ok;
+    });
+    
+    runProtectedTest("Array reduce, some, every and find", []() -> bool {
+        int values[] = {3, 8, 12, 5};
+        Array arr;
+        for (int i = 0; i < 4; i++) arr.push(&values[i]);
+        int total = arr.reduce([](int acc, void* value, size_t) { return acc + *(int*)value; }, 0);
+        int visited = 0;
+        bool has_big = arr.some([&](void* value, size_t) { visited++; return *(int*)value > 10; });
+        bool all_positive = arr.every([](void* value, size_t) { return *(int*)value > 0; });
+        void* found = arr.find([](void* value, size_t) { return *(int*)value % 4 == 0; });
+        return total == 28 && has_big && visited == 3 && all_positive &&
+               found == &values[1] &&
+               arr.findIndex([](void* value, size_t) { return *(int*)value == 99; }) == Array::npos;
+    });
+    
+    runProtectedTest("Array lazy pipeline fuses stages", []() -> bool {
+        int values[100];
+        int squares[100];
+        Array arr;
+        for (int i = 0; i < 100; i++) {
+            values[i] = i;
+            squares[i] = i * i;
+            arr.push(&values[i]);
+        }
+        int filter_calls = 0;
+        long sum = arr.lazy()
+            .filter([&](void* value, size_t) { filter_calls++; return *(int*)value % 3 == 0; })
+            .map([&](void*, size_t index) -> void* { return &squares[index]; })
+            .reduce([](long acc, void* value, size_t) { return acc + *(int*)value; }, 0L);
+        
+        // Early exit: stops at the first multiple of 7 above 50
+        int visited = 0;
+        void* found = arr.lazy()
+            .filter([&](void* value, size_t) { visited++; return *(int*)value > 50; })
+            .find([](void* value, size_t) { return *(int*)value % 7 == 0; });
+        
+        Array* collected = arr.lazy().filter([](void* value, size_t) { return *(int*)value < 4; }).toArray();
+        bool ok = sum == 112761 && filter_calls == 100 &&
+                  found == &values[56] && visited == 57 &&
+                  collected->getLength() == 4;
+        delete collected;
+        return ok;
+    });
+    
+    printLine("\n[Parallel]");
+    runProtectedTest("Array parallelForEach and parallelMap", []() -> bool {
+        static int values[200000];
+        Array arr(200000);
+        for (int i = 0; i < 200000; i++) {
+            values[i] = i;
+            arr.push(&values[i]);
+        }
+        long sum = 0;
+        arr.parallelForEach([&](void* value, size_t) {
+            __atomic_add_fetch(&sum, (long)*(int*)value, __ATOMIC_RELAXED);
+        }, 1000);
+        Array* mirrored = arr.parallelMap([&](void*, size_t index) -> void* {
+            return &values[199999 - index];
+        });
+        bool ok = sum == 19999900000L &&
+                  mirrored->getLength() == 200000 &&
+                  *(int*)mirrored->get(0) == 199999 &&
+                  *(int*)mirrored->get(123456) == 76543;
+        delete mirrored;
+        return ok;
+    });
+    
+    runProtectedTest("Array parallelReduce is deterministic", []() -> bool {
+        static double values[100000];
+        Array arr(100000);
+        for (int i = 0; i < 100000; i++) {
+            values[i] = 1.0 / (i + 1);
+            arr.push(&values[i]);
+        }
+        auto add = [](double acc, void* value, size_t) { return acc + *(double*)value; };
+        auto combine = [](double a, double b) { return a + b; };
+        double first = arr.parallelReduce(add, combine, 0.0, 512);
+        double second = arr.parallelReduce(add, combine, 0.0, 512);
+        
+        // Same chunking done serially gives the bit-identical result
+        double serial = 0.0;
+        for (int chunk = 0; chunk < 100000; chunk += 512) {
+            double partial = 0.0;
+            for (int i = chunk; i < chunk + 512 && i < 100000; i++) partial += values[i];
+            serial += partial;
+        }
+        return first == second && first == serial;
+    });
+    
+    runProtectedTest("Array parallelSort", []() -> bool {
+        static int values[300000];
+        Array arr(300000);
+        for (int i = 0; i < 300000; i++) {
+            values[i] = (int)(((unsigned)i * 2654435761u) % 1000);
+            arr.push(&values[i]);
+        }
+        Array::Comparator by_value = [](void* a, void* b) -> int { return *(int*)a - *(int*)b; };
+        arr.parallelSort(by_value, true, 10000);
+        for (size_t i = 1; i < 300000; i++) {
+            int* prev = (int*)arr.get(i - 1);
+            int* cur = (int*)arr.get(i);
+            // Ascending, and equal values keep their original (address) order
+            if (*prev > *cur || (*prev == *cur && prev > cur)) return false;
+        }
+        return true;
+    });
+    
+    printLine("\n[Small Buffer]");
+    runProtectedTest("Array default construction is lazy", []() -> bool {
+        Array arr;
+        bool empty = arr.getCapacity() == 0;
+        int value = 3;
+        arr.push(&value);
+        return empty && arr.getCapacity() == 8 && *(int*)arr.get(0) == 3;
+    });
+    
+    runProtectedTest("SmallArray spills and returns inline", []() -> bool {
+        SmallArray<4> arr;
+        int values[10];
+        for (int i = 0; i < 4; i++) {
+            values[i] = i;
+            arr.push(&values[i]);
+        }
+        bool inline_full = arr.isInline() && arr.getCapacity() == 4;
+        for (int i = 4; i < 10; i++) {
+            values[i] = i;
+            arr.push(&values[i]);
+        }
+        bool spilled = !arr.isInline() && *(int*)arr.get(9) == 9 && *(int*)arr.get(0) == 0;
+        arr.removeRange(2, 8);
+        arr.shrinkToFit();
+        return inline_full && spilled &&
+               arr.isInline() && arr.getLength() == 2 && *(int*)arr.get(1) == 1;
+    });
+    
+    printLine("\n[Ownership]");
+    runProtectedTest("Array move and swap steal storage", []() -> bool {
+        int values[6];
+        Array source;
+        for (int i = 0; i < 6; i++) source.push(&values[i]);
+        
+        Array moved(static_cast<Array&&>(source));
+        bool ok = source.isEmpty() && moved.getLength() == 6 && moved.get(5) == &values[5];
+        
+        SmallArray<4> small;
+        small.push(&values[0]);
+        Array from_inline(static_cast<Array&&>(small)); // Inline elements are copied out
+        ok = ok && small.isEmpty() && small.isInline() && from_inline.get(0) == &values[0];
+        
+        moved.swap(from_inline);
+        Array copy(moved);
+        return ok && moved.getLength() == 1 && from_inline.getLength() == 6 &&
+               copy.getLength() == 1 && copy.get(0) == &values[0] && copy.getDeleter() == nullptr;
+    });
+    
+    runProtectedTest("Owning Array deletes dropped elements", []() -> bool {
+        tracked_live = 0;
+        {
+            Array owner;
+            owner.ownAs<Tracked>();
+            for (int i = 0; i < 10; i++) owner.push(new Tracked(i));
+            owner.set(0, new Tracked(100));   // Old element 0 is deleted
+            owner.removeRange(1, 2);          // Two more
+            Tracked* popped = (Tracked*)owner.pop(); // Handed to us
+            delete popped;
+            Array* spliced = owner.splice(0, 2); // Result inherits the deleter
+            delete spliced;
+            if (tracked_live != 5 || owner.getLength() != 5) return false;
+            
+            Array moved(static_cast<Array&&>(owner));
+        }
+        return tracked_live == 0;
+    });
+    
+    runProtectedTest("string split owns its pieces; moves leave source empty", []() -> bool {
+        Luna::std::string csv("a,b,c");
+        Array* parts = csv.split(",");
+        bool ok = parts->getLength() == 3 && *(Luna::std::string*)parts->get(2) == "c" && parts->getDeleter() != nullptr;
+        delete parts; // Frees the strings too
+        
+        Luna::std::string first("hello");
+        Luna::std::string second(static_cast<Luna::std::string&&>(first));
+        Luna::std::string third("x");
+        third = static_cast<Luna::std::string&&>(second);
+        third.swap(first);
+        Luna::std::string joined = Luna::std::string("a") + "b" + csv;
+        return ok && second.empty() && second.c_str()[0] == '\0' && first == "hello" &&
+               third.empty() && joined == "aba,b,c";
+    });
+    
+    printLine("\n[Typed Arrays]");
+    runProtectedTest("ArrayOf<double> push, insert and remove", []() -> bool {
+        ArrayOf<double> arr;
+        for (int i = 0; i < 100; i++) arr.push(i * 0.5);
+        arr.insert(0, -1.0);
+        double removed = 0;
+        bool ok = arr.remove(51, &removed);
+        return ok && removed == 25.0 &&
+               arr.getLength() == 100 &&
+               arr[0] == -1.0 && arr[1] == 0.0 && arr[51] == 25.5 &&
+               arr.indexOf(49.5) == 99 &&
+               arr.indexOf(7.25) == ArrayOf<double>::npos;
+    });
+    
+    runProtectedTest("ArrayOf<int32_t> bulk operations", []() -> bool {
+        int32_t values[] = {1, 2, 3, 4, 5};
+        ArrayOf<int32_t> arr;
+        arr.pushAll(values, 5);
+        arr.insertAll(1, arr.getData() + 3, 2); // Aliased source
+        arr.removeRange(5, 2);
+        arr.reverse();
+        ArrayOf<int32_t>* tail = arr.slice(2);
+        // arr: [3, 2, 5, 4, 1]
+        bool ok = arr.getLength() == 5 && arr[0] == 3 && arr[3] == 4 &&
+                  tail->getLength() == 3 && (*tail)[0] == 5;
+        delete tail;
+        return ok;
+    });
+    
+    runProtectedTest("ArrayOf<Number> storage is unboxed", []() -> bool {
+        ArrayOf<Number> arr(2);
+        arr.push(Number(1));
+        arr.push(Number(2.5));
+        arr.push(Number(3));
+        Number last(0);
+        arr.pop(&last);
+        return arr.getLength() == 2 &&
+               arr.get(1) == arr.getData() + 1 &&
+               arr.contains(Number(2.5)) &&
+               last.equals(Number(3));
+    });
+    
+    runProtectedTest("ArrayOf destroys non-trivial elements", []() -> bool {
+        tracked_live = 0;
+        {
+            ArrayOf<Tracked> arr;
+            for (int i = 0; i < 50; i++) arr.push(Tracked(i));
+            arr.removeRange(10, 5);
+            arr.shrinkToFit();
+            if (tracked_live != 45 || arr[10].value != 15) return false;
+        }
+        return tracked_live == 0;
+    });
+    
+    runProtectedTest("ArrayOf splice and copyWithin", []() -> bool {
+        int32_t values[] = {0, 1, 2, 3, 4, 5};
+        int32_t inserted[] = {10, 11, 12};
+        ArrayOf<int32_t> arr;
+        arr.pushAll(values, 6);
+        ArrayOf<int32_t>* removed = arr.splice(1, 2, inserted, 3);
+        // arr: [0, 10, 11, 12, 3, 4, 5]
+        bool ok = removed->getLength() == 2 && (*removed)[0] == 1 && (*removed)[1] == 2 &&
+                  arr.getLength() == 7 && arr[1] == 10 && arr[3] == 12 && arr[4] == 3;
+        delete removed;
+        arr.copyWithin(0, 4); // [3, 4, 5, 12, 3, 4, 5]
+        ok = ok && arr[0] == 3 && arr[2] == 5 && arr[3] == 12;
+        
+        tracked_live = 0;
+        {
+            ArrayOf<Tracked> tracked;
+            for (int i = 0; i < 8; i++) tracked.push(Tracked(i));
+            ArrayOf<Tracked>* cut = tracked.splice(2, 3, tracked.getData() + 5, 2); // Aliased source
+            tracked.copyWithin(1, 0, 3);
+            // tracked: [0, 0, 1, 5, 5, 6, 7]
+            ok = ok && cut->getLength() == 3 && (*cut)[2].value == 4 && tracked.getLength() == 7 &&
+                 tracked[1].value == 0 && tracked[2].value == 1 && tracked[3].value == 5 && tracked[6].value == 7;
+            delete cut;
+        }
+        return ok && tracked_live == 0;
+    });
+}
+
+void testPersistentVector() {
+    printLine("\n=== PersistentVector Tests ===");
+    
+    printLine("\n[Structural Sharing]");
+    runProtectedTest("PersistentVector push and get", []() -> bool {
+        static int values[5000];
+        PersistentVector vec;
+        for (int i = 0; i < 5000; i++) {
+            values[i] = i;
+            vec = vec.push(&values[i]);
+        }
+        return vec.getLength() == 5000 &&
+               vec.get(0) == &values[0] &&
+               vec.get(1057) == &values[1057] &&
+               vec.get(4999) == &values[4999] &&
+               vec.get(5000) == nullptr;
+    });
+    
+    runProtectedTest("PersistentVector snapshots are unaffected by updates", []() -> bool {
+        int a = 1, b = 2, c = 3;
+        PersistentVector base = PersistentVector().push(&a).push(&b);
+        PersistentVector snapshot = base;
+        PersistentVector changed = base.set(0, &c).push(&c);
+        PersistentVector shorter = changed.pop().pop();
+        return snapshot.getLength() == 2 && snapshot.get(0) == &a &&
+               changed.getLength() == 3 && changed.get(0) == &c && changed.get(2) == &c &&
+               shorter.getLength() == 1 && shorter.get(0) == &c;
+    });
+    
+    runProtectedTest("PersistentVector concat and slice", []() -> bool {
+        static int values[3000];
+        PersistentVector left;
+        PersistentVector right;
+        for (int i = 0; i < 3000; i++) {
+            values[i] = i;
+            if (i < 1234) {
+                left = left.push(&values[i]);
+            } else {
+                right = right.push(&values[i]);
+            }
+        }
+        PersistentVector joined = left.concat(right);
+        PersistentVector middle = joined.slice(1000, 2500);
+        // Re-joining uneven pieces exercises the relaxed (size table) path
+        PersistentVector rejoined = middle.slice(0, 7).concat(middle.slice(7));
+        
+        size_t expected = 1000;
+        for (void* value : rejoined) {
+            if (value != &values[expected++]) return false;
+        }
+        return joined.getLength() == 3000 && joined.get(1234) == &values[1234] &&
+               middle.getLength() == 1500 && middle.get(0) == &values[1000] &&
+               expected == 2500 && left.getLength() == 1234;
+    });
+    
+    runProtectedTest("TransientVector builds in place", []() -> bool {
+        static int values[1000];
+        PersistentVector seed = PersistentVector().push(&values[0]);
+        TransientVector builder = seed.transient();
+        for (int i = 1; i < 1000; i++) builder.push(&values[i]);
+        builder.set(0, &values[999]);
+        PersistentVector built = builder.persistent();
+        builder.set(1, &values[0]); // Must not leak into the snapshot
+        
+        Array* flat = built.toArray();
+        bool ok = flat->getLength() == 1000 && flat->get(0) == &values[999] && flat->get(1) == &values[1];
+        delete flat;
+        return ok && seed.getLength() == 1 && seed.get(0) == &values[0] && builder.get(1) == &values[0];
+    });
+}
+
+void testDeque() {
+    printLine("\n=== Deque Tests ===");
+    
+    printLine("\n[Both Ends]");
+    runProtectedTest("Deque push/pop/shift/unshift", []() -> bool {
+        int a = 1, b = 2, c = 3, d = 4;
+        Deque queue;
+        queue.push(&b);
+        queue.push(&c);
+        queue.unshift(&a);
+        queue.push(&d);
+        bool ok = queue.getLength() == 4 && queue.front() == &a && queue.back() == &d &&
+                  queue.get(1) == &b && queue.get(4) == nullptr;
+        ok = ok && queue.shift() == &a && queue.pop() == &d && queue.shift() == &b;
+        ok = ok && queue.pop() == &c && queue.isEmpty();
+        return ok && queue.shift() == nullptr && queue.pop() == nullptr;
+    });
+    
+    runProtectedTest("Deque as BFS work queue stays in one buffer", []() -> bool {
+        static int values[10000];
+        Deque queue(16);
+        size_t next = 0, expected = 0;
+        // Steady state of 10 in flight: the ring wraps instead of growing
+        for (int round = 0; round < 1000; round++) {
+            for (int k = 0; k < 10; k++) {
+                values[next] = (int)next;
+                queue.push(&values[next++]);
+            }
+            for (int k = 0; k < 10; k++) {
+                if (queue.shift() != &values[expected++]) return false;
+            }
+        }
+        return queue.isEmpty() && queue.getCapacity() == 16 && expected == 10000;
+    });
+    
+    printLine("\n[Segments]");
+    runProtectedTest("Deque wrapped contents split into two segments", []() -> bool {
+        static int values[12];
+        Deque queue(8);
+        for (int i = 0; i < 6; i++) queue.push(&values[i]);
+        for (int i = 0; i < 5; i++) queue.shift();
+        for (int i = 6; i < 12; i++) queue.push(&values[i]); // Wraps the ring
+        
+        size_t expected = 5, segments = 0;
+        queue.forEachSegment([&](void* const* items, size_t count) {
+            segments++;
+            for (size_t i = 0; i < count; i++) {
+                if (items[i] != &values[expected]) return;
+                expected++;
+            }
+        });
+        
+        size_t walked = 5;
+        for (void* value : queue) {
+            if (value != &values[walked++]) return false;
+        }
+        Array* flat = queue.toArray();
+        bool ok = flat->getLength() == 7 && flat->get(0) == &values[5] && flat->get(6) == &values[11];
+        delete flat;
+        return ok && segments == 2 && queue.segmentCount() == 2 && expected == 12 && walked == 12;
+    });
+    
+    runProtectedTest("Deque growth unwraps in order", []() -> bool {
+        static int values[100];
+        Deque queue;
+        for (int i = 50; i < 100; i++) queue.push(&values[i]);
+        for (int i = 49; i >= 0; i--) queue.unshift(&values[i]);
+        for (int i = 0; i < 100; i++) {
+            if (queue.get(i) != &values[i]) return false;
+        }
+        return queue.getLength() == 100;
+    });
+}
+
+void testMap() {
+    printLine("\n=== Map/Set Tests ===");
+    
+    printLine("\n[Map]");
+    runProtectedTest("Map set/get/has/remove with string keys", []() -> bool {
+        Luna::Map<Luna::std::string, int> ages;
+        ages.set("alice", 30);
+        ages.set("bob", 25);
+        ages.set("alice", 31); // Overwrite keeps one entry
+        const int* alice = ages.get("alice");
+        bool ok = ages.getSize() == 2 && alice && *alice == 31 && ages.has("bob") && !ages.has("carol");
+        ok = ok && ages.remove("bob") && !ages.remove("bob") && ages.get("bob") == nullptr;
+        return ok && ages.getSize() == 1;
+    });
+    
+    runProtectedTest("Map iterates in insertion order", []() -> bool {
+        Luna::Map<Luna::std::string, int> map;
+        const char* keys[] = { "zeta", "alpha", "mid", "beta" };
+        for (int i = 0; i < 4; i++) map.set(keys[i], i);
+        map.set("alpha", 10); // Overwrite does not move the key
+        map.remove("mid");
+        map.set("mid", 20);   // Re-added key goes to the end
+        
+        const char* expected[] = { "zeta", "alpha", "beta", "mid" };
+        const int values[] = { 0, 10, 3, 20 };
+        int at = 0;
+        for (const auto& entry : map) {
+            if (entry.key != expected[at] || entry.value != values[at]) return false;
+            at++;
+        }
+        return at == 4;
+    });
+    
+    runProtectedTest("Map Number keys use SameValueZero", []() -> bool {
+        Luna::Map<Number, int> map;
+        map.set(Number(0.0), 1);
+        map.set(Number(-0.0), 2);   // Same key as +0
+        map.set(Number::nan(), 3);
+        map.set(Number(0.0 / 0.0), 4); // Any NaN is the same key
+        map.set(Number(7), 5);
+        const int* seven = map.get(Number(7.0));
+        const int* zero = map.get(Number(0));
+        const int* nan = map.get(Number::nan());
+        return map.getSize() == 3 && seven && *seven == 5 && zero && *zero == 2 && nan && *nan == 4;
+    });
+    
+    runProtectedTest("Map storage tracks live entries under churn", []() -> bool {
+        Luna::Map<Number, int> map;
+        for (int i = 0; i < 4; i++) map.set(Number(i), i);
+        for (int i = 4; i < 200000; i++) {
+            map.set(Number(i), i);
+            map.remove(Number(i - 4)); // Always 4 live keys
+        }
+        const int* last = map.get(Number(199999));
+        return map.getSize() == 4 && map.getCapacity() <= 16 && last && *last == 199999 && !map.has(Number(199995));
+    });
+    
+    printLine("\n[Set]");
+    runProtectedTest("Set of pointers survives heavy churn", []() -> bool {
+        static int values[20000];
+        Luna::Set<int*> set;
+        for (int round = 0; round < 4; round++) {
+            for (int i = 0; i < 20000; i++) set.add(&values[i]);
+            for (int i = 0; i < 20000; i += 2) set.remove(&values[i]);
+            if (set.getSize() != 10000) return false;
+            for (int i = 0; i < 20000; i += 2) set.add(&values[i]);
+        }
+        for (int i = 0; i < 20000; i++) {
+            if (!set.has(&values[i])) return false;
+        }
+        size_t visited = 0;
+        for (int* value : set) {
+            if (value < values || value >= values + 20000) return false;
+            visited++;
+        }
+        return set.getSize() == 20000 && visited == 20000 && !set.add(&values[5]);
+    });
+}
+
+void testObject() {
+    printLine("\n=== Object Tests ===");
+    
+    printLine("\n[Shapes]");
+    runProtectedTest("Objects with the same key order share a shape", []() -> bool {
+        Object a, b, c;
+        a.set("x", Value(Number(1)));
+        a.set("y", Value(Number(2)));
+        b.set("x", Value(Number(3)));
+        b.set("y", Value(Number(4)));
+        c.set("y", Value(Number(5)));
+        c.set("x", Value(Number(6)));
+        return a.getShape() == b.getShape() && a.getShape() != c.getShape() &&
+               b.get("y").getNumber().toInt() == 4 && c.get("x").getNumber().toInt() == 6 &&
+               a.get("z").isUndefined() && !a.has("z");
+    });
+    
+    runProtectedTest("Object holds Number, string and Array values past inline slots", []() -> bool {
+        Luna::std::string name("luna");
+        Array list;
+        Object object;
+        const char* keys[] = { "a", "b", "c", "d", "e", "f", "g", "h", "i", "j" };
+        for (int i = 0; i < 10; i++) object.set(keys[i], Value(Number(i)));
+        object.set("name", Value(&name));
+        object.set("list", Value(&list));
+        object.set("c", Value(Number(2.5))); // Overwrite keeps the slot
+        
+        bool ok = object.getPropertyCount() == 12 && object.get("name").getString() == &name &&
+                  object.get("list").getArray() == &list && object.get("j").getNumber().toInt() == 9 &&
+                  object.get("c").getNumber().toDouble() == 2.5 && object.get("name").getArray() == nullptr;
+        size_t visited = 0;
+        object.forEach([&](const Luna::std::string& key, const Value& value) {
+            if (visited < 10 && (key != keys[visited] || !value.isNumber())) ok = false;
+            visited++;
+        });
+        return ok && visited == 12;
+    });
+    
+    runProtectedTest("Object remove keeps remaining order", []() -> bool {
+        Object object;
+        object.set("a", Value(Number(1)));
+        object.set("b", Value(Number(2)));
+        object.set("c", Value(Number(3)));
+        bool ok = object.remove("b") && !object.remove("b") && !object.has("b");
+        
+        Object fresh;
+        fresh.set("a", Value(Number(0)));
+        fresh.set("c", Value(Number(0)));
+        return ok && object.getShape() == fresh.getShape() && object.get("c").getNumber().toInt() == 3;
+    });
+    
+    runProtectedTest("Objects built on many threads share shapes", []() -> bool {
+        // Past the linear-lookup limit, so the slot table is built too
+        static const Shape* shapes[64];
+        static bool good[64];
+        Luna::Parallel::forRange(64, 1, [](void*, size_t begin, size_t end) {
+            for (size_t i = begin; i < end; i++) {
+                Object object;
+                char name[4] = { 't', 'k', 0, 0 };
+                for (int k = 0; k < 12; k++) {
+                    name[2] = (char)('a' + k);
+                    object.set(name, Value(Number(k)));
+                }
+                bool ok = object.get("tkl").getNumber().toInt() == 11 && object.get("tka").getNumber().toInt() == 0;
+                int expected = 0;
+                object.forEach([&](const Luna::std::string& key, const Value&) {
+                    ok = ok && key.length() == 3 && key[2] == (char)('a' + expected++);
+                });
+                good[i] = ok && expected == 12;
+                shapes[i] = object.getShape();
+            }
+        }, nullptr);
+        for (size_t i = 0; i < 64; i++) {
+            if (!good[i] || shapes[i] != shapes[0]) return false;
+        }
+        return true;
+    });
+    
+    printLine("\n[Inline Caches]");
+    runProtectedTest("PropertyCache goes mono, poly, then megamorphic", []() -> bool {
+        Object objects[6];
+        const char* extras[] = { "p", "q", "r", "s", "t", "u" };
+        for (int i = 0; i < 6; i++) {
+            objects[i].set(extras[i], Value(Number(0))); // A different shape each
+            objects[i].set("value", Value(Number(i * 10)));
+        }
+        
+        PropertyCache site("value");
+        bool ok = site.get(objects[0]).getNumber().toInt() == 0 && site.isMonomorphic();
+        ok = ok && site.get(objects[0]).getNumber().toInt() == 0 && site.isMonomorphic();
+        ok = ok && site.get(objects[1]).getNumber().toInt() == 10 && site.isPolymorphic();
+        for (int i = 2; i < 6; i++) ok = ok && site.get(objects[i]).getNumber().toInt() == i * 10;
+        return ok && site.isMegamorphic() && site.get(objects[5]).getNumber().toInt() == 50;
+    });
+    
+    runProtectedTest("PropertyCache caches add transitions", []() -> bool {
+        PropertyCache add_x("x");
+        PropertyCache add_y("y");
+        Object first, second;
+        add_x.set(first, Value(Number(1)));
+        add_y.set(first, Value(Number(2)));
+        add_x.set(second, Value(Number(3))); // Cached transition from the root shape
+        add_y.set(second, Value(Number(4)));
+        return first.getShape() == second.getShape() && add_x.isMonomorphic() &&
+               add_y.get(second).getNumber().toInt() == 4 && second.get("x").getNumber().toInt() == 3;
+    });
 }
 
 void testChar() {
@@ -651,6 +1607,44 @@ void testChar() {
         Char c = Char::fromInt(90);
         return c.getValue() == 'Z' && c.toInt() == 90;
     });
+    
+    printLine("\n[Class Table]");
+    runProtectedTest("Class bits for identifiers", []() -> bool {
+        return Char('_').is(Char::IDENTIFIER_START) && 
+               Char('$').is(Char::IDENTIFIER_START) && 
+               Char('7').is(Char::IDENTIFIER_PART) && 
+               !Char('7').is(Char::IDENTIFIER_START) && 
+               Char('f').is(Char::HEX_DIGIT) && 
+               !Char('g').is(Char::HEX_DIGIT) && 
+               !Char((char)0xE9).isLetter();
+    });
+    
+    printLine("\n[Batch Classification]");
+    runProtectedTest("skipWhitespace / skipWhitespaceReverse", []() -> bool {
+        const char* text = " \t\r\n                                   value\f\v                                  ";
+        size_t len = Luna::string::length(text);
+        size_t start = Char::skipWhitespace(text, len);
+        size_t end = Char::skipWhitespaceReverse(text, len);
+        return text[start] == 'v' && 
+               end - start == 5 && 
+               Char::skipWhitespace("   ", 3) == 3 && 
+               Char::skipWhitespaceReverse("   ", 3) == 0;
+    });
+    
+    runProtectedTest("skipDigits / allDigits", []() -> bool {
+        const char* digits = "12345678901234567890123456789012345678901234567890x";
+        return Char::skipDigits(digits, 51) == 50 && 
+               Char::allDigits(digits, 50) && 
+               !Char::allDigits(digits, 51) && 
+               Char::allDigits("", 0);
+    });
+    
+    runProtectedTest("findFirstIn / findFirstNotIn", []() -> bool {
+        const char* source = "let value_1 = 42;";
+        size_t ident_end = Char::findFirstNotIn(source + 4, 13, Char::IDENTIFIER_PART);
+        return Char::findFirstIn(source, 17, Char::DIGIT) == 10 && 
+               ident_end == 7;
+    });
 }
 
 void testIntegration() {
@@ -818,6 +1812,24 @@ void testConsole() {
         return true;
     });
     
+    runProtectedTest("Log multiple values from inline storage", []() -> bool {
+        SmallArray<4> values;
+        values.push(new Number(42));
+        values.push(new Char('X'));
+        values.push(new Boolean(true));
+        values.push(new Number(3.14));
+        bool stayed_inline = values.isInline();
+        
+        Luna::Console::logMultiple(&values);
+        
+        // Cleanup
+        for (size_t i = 0; i < values.getLength(); i++) {
+            delete (void*)values.get(i);
+        }
+        
+        return stayed_inline;
+    });
+    
     printLine("\n[Value to String Conversion]");
     runProtectedTest("Convert Number to string", []() -> bool {
         Number num(123);
@@ -861,6 +1873,39 @@ void testStrings() {
                Luna::string::compare(s1, s3) < 0;
     });
     
+    runProtectedTest("Vectorized C-string scans at every alignment", []() -> bool {
+        char* buffer = (char*)Luna::Memory::allocate(256);
+        char* other = (char*)Luna::Memory::allocate(256);
+        Luna::Memory::set(buffer, 'x', 256);
+        Luna::Memory::set(other, 'x', 256);
+        bool ok = true;
+        for (size_t start = 0; start < 40 && ok; start++) {
+            for (size_t len = 0; len < 100 && ok; len += 7) {
+                buffer[start + len] = '\0';
+                other[start + len] = '\0';
+                ok = Luna::string::length(buffer + start) == len &&
+                     Luna::string::compare(buffer + start, other + start) == 0;
+                if (len > 0) {
+                    other[start + len - 1] = 'y'; // Last byte differs
+                    ok = ok && Luna::string::compare(buffer + start, other + start) < 0 &&
+                         Luna::string::find(buffer + start, 'y') == nullptr &&
+                         Luna::string::find(other + start, 'y') == other + start + len - 1;
+                    other[start + len - 1] = 'x';
+                }
+                buffer[start + len] = 'x';
+                other[start + len] = 'x';
+            }
+        }
+        Luna::Memory::deallocate(buffer);
+        Luna::Memory::deallocate(other);
+        
+        Luna::std::string text("the quick brown fox jumps over the lazy dog, again and again");
+        return ok && text.find('z') == 37 && text.find('g', 44) == 46 && text.find('!') == Luna::std::npos &&
+               Luna::std::string("apple") < Luna::std::string("apples") &&
+               Luna::std::string("b") > Luna::std::string("abc") &&
+               text.endsWith("again") && text.startsWith("the quick");
+    });
+    
     runProtectedTest("string::duplicate", []() -> bool {
         const char* original = "Test String";
         char* copy = Luna::string::duplicate(original);
@@ -908,6 +1953,363 @@ void testStrings() {
         return s.find("World") == 6 && 
                s.substr(0, 5) == "Hello";
     });
+    
+    runProtectedTest("std::string keeps short strings inline", []() -> bool {
+        Luna::std::string empty_str;
+        Luna::std::string small("twenty-three characters"); // 23 bytes: the inline limit
+        Luna::std::string large("twenty-four characters!!");
+        const char* small_begin = (const char*)&small;
+        bool inline_small = small.c_str() >= small_begin && small.c_str() < small_begin + sizeof(small);
+        const char* large_begin = (const char*)&large;
+        bool heap_large = large.c_str() < large_begin || large.c_str() >= large_begin + sizeof(large);
+        
+        Luna::std::string grown(small);
+        grown.push_back('!'); // Spills to the heap
+        Luna::std::string moved(static_cast<Luna::std::string&&>(small));
+        return sizeof(Luna::std::string) == 24 && empty_str.c_str()[0] == '\0' &&
+               small.empty() && inline_small && heap_large &&
+               moved.length() == 23 && moved == "twenty-three characters" &&
+               grown.length() == 24 && grown.substr(20) == "ers!" && large.length() == 24;
+    });
+    
+    runProtectedTest("std::string grows geometrically", []() -> bool {
+        Luna::std::string built;
+        size_t reallocations = 0;
+        size_t last_capacity = built.capacity();
+        for (size_t i = 0; i < (1 << 20); i++) {
+            built.push_back((char)('a' + i % 26));
+            if (built.capacity() != last_capacity) {
+                reallocations++;
+                last_capacity = built.capacity();
+            }
+        }
+        bool ok = built.length() == (1 << 20) && reallocations < 20 && built[(1 << 20) - 1] == 'a' + ((1 << 20) - 1) % 26;
+        
+        Luna::std::string text("short");
+        text.reserve(100);
+        ok = ok && text.capacity() >= 100 && text == "short";
+        text.shrink_to_fit(); // Back inline
+        ok = ok && text.capacity() == 23 && text == "short";
+        built.shrink_to_fit();
+        return ok && built.capacity() == built.length();
+    });
+    
+    runProtectedTest("std::string find with short and long needles", []() -> bool {
+        Luna::std::string text("abababababababababababababababababababac, abcabcabd and a needle in a haystack");
+        Luna::std::string periodic("abababababababababac"); // Long, highly periodic needle
+        bool ok = text.find(periodic) == 20 && text.find("abcabd") == 45 && text.find("needle") == 58 &&
+                  text.find("haystack", 70) == 70 && text.find("haystacks") == Luna::std::npos &&
+                  text.find("ab", 39) == 42 && text.includes("abcabcabd") && !text.includes("abcabcabe");
+        
+        // Needle longer than the filter width, repeating every 3 bytes
+        Luna::std::string big;
+        for (size_t i = 0; i < 5000; i++) big.push_back((char)('a' + (i * 7) % 3));
+        Luna::std::string tail = big.substr(4900);
+        return ok && big.find(tail) == 1 && big.find(tail, 4900) == 4900 && big.find(big) == 0 && big.find(tail, 4901) == Luna::std::npos;
+    });
+    
+    runProtectedTest("std::string lastIndexOf and count", []() -> bool {
+        Luna::std::string text("one fish, two fish, red fish, blue fish");
+        Luna::std::string runs("aaaaaaa");
+        Luna::Searcher fish("fish", 4); // Reused across searches
+        return text.lastIndexOf("fish") == 35 && text.lastIndexOf("fish", 34) == 24 &&
+               text.lastIndexOf("fish", 4) == 4 && text.lastIndexOf("fish", 3) == Luna::std::npos &&
+               text.lastIndexOf("") == text.length() && text.lastIndexOf("", 3) == 3 &&
+               text.count("fish") == 4 && runs.count("aa") == 3 && runs.count("b") == 0 &&
+               fish.find(text.c_str(), text.length(), 5) == 14 &&
+               fish.findLast(text.c_str(), text.length()) == 35 && fish.count(text.c_str(), text.length()) == 4;
+    });
+    
+    runProtectedTest("Searcher one-byte needles scan in blocks", []() -> bool {
+        Luna::std::string text;
+        for (size_t i = 0; i < 1000; i++) text.push_back(i == 3 || i == 500 || i == 997 ? 'x' : 'a');
+        Luna::Searcher x("x", 1);
+        const char* data = text.c_str();
+        return x.find(data, 1000) == 3 && x.find(data, 1000, 4) == 500 && x.find(data, 1000, 501) == 997 &&
+               x.find(data, 1000, 998) == Luna::Searcher::npos && x.findLast(data, 1000) == 997 &&
+               x.findLast(data, 1000, 996) == 500 && x.findLast(data, 1000, 499) == 3 &&
+               x.findLast(data, 1000, 2) == Luna::Searcher::npos && x.count(data, 1000) == 3 &&
+               text.lastIndexOf("x", 600) == 500 && text.find('x', 4) == 500;
+    });
+    
+    runProtectedTest("std::string split and replace share one searcher", []() -> bool {
+        Luna::std::string csv("a::bb::::ccc::");
+        Array* parts = csv.split("::");
+        bool ok = parts->getLength() == 5 &&
+                  *(Luna::std::string*)parts->get(1) == "bb" && ((Luna::std::string*)parts->get(2))->empty() &&
+                  *(Luna::std::string*)parts->get(3) == "ccc" && ((Luna::std::string*)parts->get(4))->empty();
+        delete parts;
+        return ok && csv.replaceAll("::", "/") == "a/bb//ccc/";
+    });
+    
+    runProtectedTest("std::string concatenation builds a lazy rope", []() -> bool {
+        Luna::std::string built;
+        Luna::std::string nested;
+        Luna::std::string expected;
+        for (size_t i = 0; i < 20000; i++) {
+            Luna::std::string piece((char)('a' + i % 26));
+            built = built + piece;                        // Left-deep
+            nested = Luna::std::string("(") + nested + ")"; // Wraps on both sides
+            expected.push_back((char)('a' + i % 26));
+        }
+        Luna::std::string copy(built); // Shares the rope
+        bool ok = built.isRope() && copy.isRope() && nested.isRope() && built.length() == 20000;
+        const char* text = built.c_str(); // First read caches one buffer for every sharer
+        ok = ok && built == expected && built.isRope() && copy.c_str() == text;
+        ok = ok && copy.at(19999) == expected[19999] && copy.isRope();
+        copy.push_back('!'); // Writing flattens
+        ok = ok && !copy.isRope() && copy.length() == 20001 && built.c_str() == text;
+        ok = ok && nested.length() == 40000 && nested[19999] == '(' && nested[20000] == ')';
+        
+        Luna::std::string short_result = Luna::std::string("ab") + "cd";
+        return ok && !short_result.isRope() && short_result == "abcd" && built.concat("!").endsWith("f!");
+    });
+    
+    runProtectedTest("std::string rope read from many threads at once", []() -> bool {
+        static Luna::std::string shared;
+        static const char* seen[64];
+        shared = Luna::std::string();
+        for (size_t i = 0; i < 2000; i++) shared = shared + Luna::std::string((char)('a' + i % 26));
+        if (!shared.isRope()) return false;
+        
+        // Every reader races to build the flat copy; exactly one is kept
+        Luna::Parallel::forRange(64, 1, [](void*, size_t begin, size_t end) {
+            for (size_t i = begin; i < end; i++) seen[i] = shared.c_str();
+        }, nullptr);
+        bool ok = shared.isRope() && seen[0][1999] == 'x';
+        for (size_t i = 1; i < 64 && ok; i++) ok = seen[i] == seen[0];
+        shared = Luna::std::string();
+        return ok;
+    });
+    
+    runProtectedTest("std::string assigns a suffix of its own rope", []() -> bool {
+        Luna::std::string half;
+        for (size_t i = 0; i < 200; i++) half.push_back((char)('a' + i % 26));
+        Luna::std::string rope = half + half;
+        const Luna::std::string& reader = rope;
+        rope = reader.c_str() + 100; // Points into the rope's cached flat copy
+        return !rope.isRope() && rope.length() == 300 && rope.endsWith(half) && rope[0] == half[100];
+    });
+    
+    runProtectedTest("std::string reserve on a rope keeps its bytes", []() -> bool {
+        Luna::std::string half;
+        for (size_t i = 0; i < 200; i++) half.push_back((char)('a' + i % 26));
+        Luna::std::string rope = half + half;
+        bool ok = rope.isRope() && rope.capacity() >= rope.length();
+        rope.reserve(10); // Below the length: nothing to do
+        ok = ok && rope.length() == 400 && rope.startsWith(half) && rope.endsWith(half);
+        rope = half + half;
+        rope.reserve(1000);
+        return ok && !rope.isRope() && rope.capacity() >= 1000 && rope.length() == 400 && rope.endsWith(half);
+    });
+    
+    runProtectedTest("std::string intern gives canonical handles", []() -> bool {
+        Luna::std::string built = Luna::std::string("ident") + "ifier";
+        Luna::Interned a = built.intern();
+        Luna::Interned b = Luna::Interned::of("identifier");
+        Luna::Interned c = Luna::Interned::of("identifiers", 10); // Same bytes, other buffer
+        bool ok = a == b && b == c && a.c_str() == b.c_str() && a != Luna::Interned::of("identify") &&
+                  a.hash() == Luna::Hash::bytes("identifier", 10) && a.length() == 10 &&
+                  Luna::Interned::of("") == Luna::Interned() && Luna::std::string().intern().empty();
+        
+        // Threads racing to intern the same names agree on one handle each
+        static Luna::Interned seen[512];
+        Luna::Parallel::forRange(512, 8, [](void*, size_t begin, size_t end) {
+            for (size_t i = begin; i < end; i++) {
+                char name[8] = { 'v', 'a', 'r', (char)('a' + i % 16), 0 };
+                seen[i] = Luna::Interned::of(name);
+            }
+        }, nullptr);
+        for (size_t i = 16; i < 512 && ok; i++) ok = seen[i] == seen[i % 16] && seen[i] != seen[(i + 1) % 16];
+        
+        size_t before = Luna::Interned::count();
+        Luna::Interned::of("identifier");
+        return ok && Luna::Interned::count() == before;
+    });
+    
+    runProtectedTest("StringView queries without copying", []() -> bool {
+        const char* text = "  width=120, height=-45  ";
+        Luna::StringView all(text);
+        Luna::StringView trimmed = all.trim();
+        Luna::StringView width = trimmed.substr(6, 3);
+        Luna::StringView height = trimmed.substr(trimmed.find('=', 10) + 1);
+        return trimmed.data() == text + 2 && trimmed.length() == 21 &&
+               width == "120" && width.toInt() == 120 && width.toDouble() == 120.0 &&
+               height == "-45" && height.toInt() == -45 &&
+               trimmed.startsWith("width") && trimmed.endsWith("-45") && !trimmed.endsWith("  ") &&
+               trimmed.find("height") == 11 && trimmed.lastIndexOf("h") == 15 && trimmed.includes(", ") &&
+               width < height.substr(1) && width.compare("120") == 0 && Luna::StringView("abc") < Luna::StringView("abd") &&
+               Luna::StringView(text, 2).trim().empty() && width.toString() == "120";
+    });
+    
+    runProtectedTest("std::string view variants point into the parent", []() -> bool {
+        Luna::std::string line("  alpha,beta,,gamma  ");
+        const char* base = line.c_str();
+        Luna::StringView trimmed = line.trimView();
+        ArrayOf<Luna::StringView>* fields = trimmed.split(",");
+        bool ok = trimmed.data() == base + 2 && line.substrView(2, 5) == "alpha" &&
+                  fields->getLength() == 4 && (*fields)[1] == "beta" && (*fields)[2].empty() &&
+                  (*fields)[3] == "gamma" && (*fields)[3].data() == base + 14;
+        delete fields;
+        
+        ArrayOf<Luna::StringView>* whole = line.splitView(";");
+        ok = ok && whole->getLength() == 1 && (*whole)[0].data() == base && (*whole)[0] == line;
+        delete whole;
+        return ok && line == line.view() && line.trim() == trimmed && Luna::std::string("x", 1) == "x";
+    });
+    
+    runProtectedTest("Splitter streams fields without allocating", []() -> bool {
+        Luna::std::string row("id,name,,score,rank");
+        const char* base = row.c_str();
+        size_t offsets[8];
+        size_t lengths[8];
+        size_t count = 0;
+        for (Luna::StringView field : Luna::Splitter(row.view(), ",")) {
+            offsets[count] = (size_t)(field.data() - base);
+            lengths[count] = field.length();
+            count++;
+        }
+        bool ok = count == 5 && offsets[1] == 3 && lengths[1] == 4 && lengths[2] == 0 &&
+                  offsets[4] == 15 && lengths[4] == 4;
+        
+        // JS split(separator, limit): at most limit fields, the rest is dropped
+        Luna::Splitter limited(row.view(), ",", 2);
+        Luna::StringView first, second, third;
+        ok = ok && limited.next(&first) && limited.next(&second) && !limited.next(&third) &&
+             first == "id" && second == "name";
+        
+        Luna::Splitter words(Luna::StringView("alpha::beta::gamma"), "::");
+        size_t total = 0;
+        ok = ok && words.forEach([&](Luna::StringView word) { total += word.length(); }) == 3 && total == 14;
+        
+        Array* parts = row.split(",", 3);
+        ok = ok && parts->getLength() == 3 && ((Luna::std::string*)parts->get(2))->empty();
+        delete parts;
+        return ok && Luna::Splitter(row.view(), ",", 0).forEach([](Luna::StringView) {}) == 0;
+    });
+    
+    runProtectedTest("Splitter on any of several delimiters", []() -> bool {
+        Luna::StringView line("a b\tc;d;;e");
+        Luna::Splitter fields = Luna::Splitter::anyOf(line, " \t;");
+        const char* expected[] = { "a", "b", "c", "d", "", "e" };
+        size_t count = 0;
+        bool ok = true;
+        for (Luna::StringView field : fields) {
+            ok = ok && count < 6 && field == expected[count];
+            count++;
+        }
+        Luna::Splitter none = Luna::Splitter::anyOf(line, "");
+        Luna::StringView whole;
+        return ok && count == 6 && none.next(&whole) && whole == line && !none.next(&whole) &&
+               Luna::Splitter::anyOf(line, ";", 2).forEach([](Luna::StringView) {}) == 2;
+    });
+    
+    runProtectedTest("std::string replace and replaceAll follow JS", []() -> bool {
+        Luna::std::string text("one two one two one, and a longer tail to leave the inline buffer");
+        Luna::std::string first = text.replace("one", "1");
+        Luna::std::string all = text.replaceAll("one", "uno");
+        bool ok = first.startsWith("1 two one") && first.length() == text.length() - 2 &&
+                  all.startsWith("uno two uno two uno,") && all.length() == text.length() &&
+                  all.capacity() == all.length() && // Sized exactly up front
+                  text.replace("zzz", "y") == text && text.replaceAll("zzz", "y") == text;
+        
+        Luna::std::string word("abc");
+        return ok && word.replace("", "-") == "-abc" && word.replaceAll("", "-") == "-a-b-c-" &&
+               Luna::std::string("aaaa").replaceAll("aa", "b") == "bb" &&
+               Luna::std::string("h\xC3\xA9").replaceAll("", ".") == ".h.\xC3\xA9."; // Code points stay whole
+    });
+    
+    runProtectedTest("std::string replaceMany in one scan", []() -> bool {
+        Luna::std::string patterns[] = { "<", ">", "&", "\"", "<script>" };
+        Luna::std::string replacements[] = { "&lt;", "&gt;", "&amp;", "&quot;", "" };
+        Luna::std::string html("<b>\"fish & chips\"</b><script>x</script>");
+        Luna::std::string escaped = html.replaceMany(patterns, replacements, 5);
+        bool ok = escaped == "&lt;b&gt;&quot;fish &amp; chips&quot;&lt;/b&gt;x&lt;/script&gt;" &&
+                  escaped.capacity() == escaped.length();
+        
+        // One automaton reused across documents
+        const char* names[] = { "he", "she", "hers" };
+        size_t lengths[] = { 2, 3, 4 };
+        Luna::MultiSearcher pronouns(names, lengths, 3);
+        Luna::std::string swaps[] = { "X", "Y", "Z" };
+        return ok && Luna::std::string("ushers").replaceMany(pronouns, swaps) == "uYrs" &&
+               Luna::std::string("hershe").replaceMany(pronouns, swaps) == "ZX" &&
+               Luna::std::string("none").replaceMany(pronouns, swaps) == "none";
+    });
+    
+    runProtectedTest("MultiSearcher patterns covering every byte value", []() -> bool {
+        // 256 distinct bytes need 257 classes once unused bytes get their own
+        char all[255];
+        for (size_t i = 0; i < 255; i++) all[i] = (char)i;
+        const char* patterns[] = { all, "\xFF\xFF" };
+        size_t lengths[] = { 255, 2 };
+        Luna::MultiSearcher searcher(patterns, lengths, 2);
+        Luna::MultiSearcher::Match match;
+        bool ok = !searcher.find("\x00\x00", 2, 0, &match);
+        ok = ok && searcher.find("\x01\xFF\xFF", 3, 0, &match) && match.start == 1 && match.pattern == 1;
+        
+        char hay[258];
+        hay[0] = hay[1] = '\xFF';
+        for (size_t i = 0; i < 255; i++) hay[i + 3] = (char)i;
+        hay[2] = 'x';
+        return ok && searcher.find(hay, 258, 1, &match) && match.start == 3 && match.length == 255 && match.pattern == 0;
+    });
+    
+    runProtectedTest("std::string trim", []() -> bool {
+        Luna::std::string s("  \t padded text \r\n");
+        Luna::std::string blank(" \n\t ");
+        return s.trim() == "padded text" && 
+               blank.trim().empty() && 
+               Luna::std::string("x").trim() == "x";
+    });
+    
+    printLine("\n[Unicode]");
+    runProtectedTest("UTF-8 validation", []() -> bool {
+        Luna::std::string ascii("plain ascii text that is longer than one vector block");
+        Luna::std::string mixed("caf\xC3\xA9 \xE2\x82\xAC \xF0\x9F\x98\x80 and more text after it");
+        Luna::std::string overlong("\xC0\xAF");
+        Luna::std::string surrogate("\xED\xA0\x80");
+        Luna::std::string truncated("ok \xE2\x82");
+        return ascii.isValidUtf8() && 
+               mixed.isValidUtf8() && 
+               !overlong.isValidUtf8() && 
+               !surrogate.isValidUtf8() && 
+               !truncated.isValidUtf8();
+    });
+    
+    runProtectedTest("Code point and UTF-16 length", []() -> bool {
+        Luna::std::string s("a\xC3\xA9\xE2\x82\xAC\xF0\x9F\x98\x80");
+        return s.length() == 10 && 
+               s.codePointLength() == 4 && 
+               s.utf16Length() == 5;
+    });
+    
+    runProtectedTest("UTF-8 <-> UTF-16 round trip", []() -> bool {
+        Luna::std::string s("x\xC3\xA9\xF0\x9F\x98\x80 0123456789abcdef");
+        size_t units = 0;
+        uint16_t* utf16 = s.toUtf16(&units);
+        bool result = utf16 != nullptr && 
+                      units == 21 && 
+                      utf16[0] == 'x' && utf16[1] == 0xE9 && 
+                      utf16[2] == 0xD83D && utf16[3] == 0xDE00;
+        if (utf16) {
+            result = result && Luna::std::string::fromUtf16(utf16, units) == s;
+            Luna::Memory::deallocate(utf16);
+        }
+        return result;
+    });
+    
+    runProtectedTest("Code point iteration", []() -> bool {
+        Luna::std::string s("A\xC3\xA9\xFF\xF0\x9F\x98\x80");
+        uint32_t expected[] = {0x41, 0xE9, 0xFFFD, 0x1F600};
+        size_t count = 0;
+        bool result = true;
+        for (uint32_t cp : s.codePoints()) {
+            if (count >= 4 || cp != expected[count]) result = false;
+            count++;
+        }
+        return result && count == 4;
+    });
 }
 
 // Add math tests
@@ -945,6 +2347,26 @@ void testMath() {
         return result.greaterThan(Number(0.999)) && result.lessThan(Number(1.001));
     });
     
+    runProtectedTest("min/max over typed arrays", []() -> bool {
+        ArrayOf<double> doubles;
+        ArrayOf<int32_t> ints;
+        ArrayOf<Number> numbers;
+        for (int i = 0; i < 37; i++) {
+            doubles.push((i * 7919) % 101 - 50.5);
+            ints.push((i * 7919) % 101 - 50);
+            numbers.push(Number((i * 7919) % 101 - 50));
+        }
+        bool ok = Luna::Math::min(doubles).equals(Number(-50.5)) &&
+                  Luna::Math::max(doubles).equals(Number(49.5)) &&
+                  Luna::Math::min(ints).equals(Number(-50)) &&
+                  Luna::Math::max(ints).equals(Number(50)) &&
+                  Luna::Math::min(numbers).equals(Number(-50)) &&
+                  Luna::Math::max(numbers).equals(Number(50));
+        doubles.push(NAN);
+        return ok && Luna::Math::min(doubles).isNaN() &&
+               Luna::Math::min(ArrayOf<int32_t>()).isNaN();
+    });
+    
     printLine("\n[Math Constants]");
     runProtectedTest("PI constant", []() -> bool {
         return Luna::Math::constants::PI > 3.14159 && Luna::Math::constants::PI < 3.14160;
@@ -983,6 +2405,36 @@ void testMath() {
         return result.equals(Number(42));
     });
     
+    runProtectedTest("Symbol evaluation with inline variables", []() -> bool {
+        Luna::Math::Symbol x("x");
+        SmallArray<2> vars; // One (symbol, value) pair stays inline
+        vars.push(&x);
+        vars.push(new Number(42));
+        Number result = x.evaluate(vars);
+        bool stayed_inline = vars.isInline();
+        
+        // Cleanup
+        delete (Number*)vars.get(1);
+        return stayed_inline && result.equals(Number(42));
+    });
+    
+    runProtectedTest("Symbols with equal names share an interned name", []() -> bool {
+        Luna::Math::Symbol x("x");
+        Luna::Math::Symbol also_x(Luna::std::string("x").c_str());
+        Luna::Math::Symbol y("y");
+        SmallArray<4> vars;
+        vars.push(&y);
+        vars.push(new Number(1));
+        vars.push(&x);
+        vars.push(new Number(7));
+        Number result = also_x.evaluate(vars);
+        
+        delete (Number*)vars.get(1);
+        delete (Number*)vars.get(3);
+        return result.equals(Number(7)) && x.getInternedName() == also_x.getInternedName() &&
+               x.getInternedName() != y.getInternedName() && x.getName() == also_x.getName();
+    });
+    
     printLine("\n[Symbolic Math - Differentiation]");
     runProtectedTest("Derivative of constant", []() -> bool {
         Luna::Math::Constant five(5);
@@ -1076,6 +2528,17 @@ int main() {
         signal(suite_sig, crash_handler);
     }
     
+    suite_sig = setjmp(recovery_point);
+    if (suite_sig == 0) {
+        in_protected_block = 1;
+        testBooleanArray();
+        in_protected_block = 0;
+    } else {
+        in_protected_block = 0;
+        printf("\n[ERROR] testBooleanArray() suite crashed with signal %d - continuing...\n\n", suite_sig);
+        signal(suite_sig, crash_handler);
+    }
+    
     suite_sig = setjmp(recovery_point);
     if (suite_sig == 0) {
         in_protected_block = 1;
@@ -1098,6 +2561,50 @@ int main() {
         signal(suite_sig, crash_handler);
     }
     
+    suite_sig = setjmp(recovery_point);
+    if (suite_sig == 0) {
+        in_protected_block = 1;
+        testPersistentVector();
+        in_protected_block = 0;
+    } else {
+        in_protected_block = 0;
+        printf("\n[ERROR] testPersistentVector() suite crashed with signal %d - continuing...\n\n", suite_sig);
+        signal(suite_sig, crash_handler);
+    }
+    
+    suite_sig = setjmp(recovery_point);
+    if (suite_sig == 0) {
+        in_protected_block = 1;
+        testDeque();
+        in_protected_block = 0;
+    } else {
+        in_protected_block = 0;
+        printf("\n[ERROR] testDeque() suite crashed with signal %d - continuing...\n\n", suite_sig);
+        signal(suite_sig, crash_handler);
+    }
+    
+    suite_sig = setjmp(recovery_point);
+    if (suite_sig == 0) {
+        in_protected_block = 1;
+        testMap();
+        in_protected_block = 0;
+    } else {
+        in_protected_block = 0;
+        printf("\n[ERROR] testMap() suite crashed with signal %d - continuing...\n\n", suite_sig);
+        signal(suite_sig, crash_handler);
+    }
+    
+    suite_sig = setjmp(recovery_point);
+    if (suite_sig == 0) {
+        in_protected_block = 1;
+        testObject();
+        in_protected_block = 0;
+    } else {
+        in_protected_block = 0;
+        printf("\n[ERROR] testObject() suite crashed with signal %d - continuing...\n\n", suite_sig);
+        signal(suite_sig, crash_handler);
+    }
+    
     suite_sig = setjmp(recovery_point);
     if (suite_sig == 0) {
         in_protected_block = 1;
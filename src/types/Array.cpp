@@ -1,21 +1,333 @@
 #include "Array.hpp"
 #include "lib/memory.hpp"
+#include "lib/cpu.hpp"
+#include "lib/sort.hpp"
+#include "types/Number.hpp"
+#include "types/Strings.hpp"
+#include <immintrin.h>
 
-Array::Array() : capacity(8), length(0) {
-    data = (void**)Luna::Memory::allocate(capacity * sizeof(void*));
-    Luna::Memory::set(data, 0, capacity * sizeof(void*));
+// ===== POINTER SEARCH KERNELS =====
+// Each kernel scans the whole range, including its scalar tail.
+
+static size_t findPointerScalar(void* const* data, size_t start, size_t count, void* value) {
+    for (size_t i = start; i < count; i++) {
+        if (data[i] == value) return i;
+    }
+    return Array::npos;
+}
+
+/**
+ * @brief 4 pointers per step; SSE2 has no 64-bit compare, so both 32-bit halves must match
+ */
+static size_t findPointerSse2(void* const* data, size_t count, void* value) {
+    __m128i needle = _mm_set1_epi64x((long long)value);
+    size_t i = 0;
+    for (; i + 4 <= count; i += 4) {
+        __m128i a = _mm_cmpeq_epi32(_mm_loadu_si128((const __m128i*)(data + i)), needle);
+        __m128i b = _mm_cmpeq_epi32(_mm_loadu_si128((const __m128i*)(data + i + 2)), needle);
+        a = _mm_and_si128(a, _mm_shuffle_epi32(a, _MM_SHUFFLE(2, 3, 0, 1)));
+        b = _mm_and_si128(b, _mm_shuffle_epi32(b, _MM_SHUFFLE(2, 3, 0, 1)));
+        int mask = _mm_movemask_pd(_mm_castsi128_pd(a)) | (_mm_movemask_pd(_mm_castsi128_pd(b)) << 2);
+        if (mask) return i + (size_t)__builtin_ctz(mask);
+    }
+    return findPointerScalar(data, i, count, value);
+}
+
+__attribute__((target("avx2")))
+static size_t findPointerAvx2(void* const* data, size_t count, void* value) {
+    __m256i needle = _mm256_set1_epi64x((long long)value);
+    size_t i = 0;
+    for (; i + 8 <= count; i += 8) {
+        __m256i a = _mm256_cmpeq_epi64(_mm256_loadu_si256((const __m256i*)(data + i)), needle);
+        __m256i b = _mm256_cmpeq_epi64(_mm256_loadu_si256((const __m256i*)(data + i + 4)), needle);
+        int mask = _mm256_movemask_pd(_mm256_castsi256_pd(a)) | (_mm256_movemask_pd(_mm256_castsi256_pd(b)) << 4);
+        if (mask) return i + (size_t)__builtin_ctz(mask);
+    }
+    return findPointerScalar(data, i, count, value);
+}
+
+__attribute__((target("avx512f")))
+static size_t findPointerAvx512(void* const* data, size_t count, void* value) {
+    __m512i needle = _mm512_set1_epi64((long long)value);
+    size_t i = 0;
+    for (; i + 16 <= count; i += 16) {
+        __mmask8 a = _mm512_cmpeq_epi64_mask(_mm512_loadu_si512((const void*)(data + i)), needle);
+        __mmask8 b = _mm512_cmpeq_epi64_mask(_mm512_loadu_si512((const void*)(data + i + 8)), needle);
+        unsigned mask = (unsigned)a | ((unsigned)b << 8);
+        if (mask) return i + (size_t)__builtin_ctz(mask);
+    }
+    return findPointerScalar(data, i, count, value);
+}
+
+// ===== MEMBERSHIP INDEX =====
+
+/**
+ * @brief Open-addressing multiset of pointers (linear probing, backward-shift delete)
+ *
+ * Counts let the index track duplicates, so removing one copy of a value
+ * keeps the others visible to contains().
+ */
+class PointerIndex {
+private:
+    struct Slot {
+        void* key;
+        size_t count; // 0 marks an empty slot
+    };
+
+    Slot* slots;
+    size_t mask;
+    size_t size;
+
+    size_t home(void* key) const {
+        unsigned long long h = (unsigned long long)key * 0x9E3779B97F4A7C15ULL;
+        return (size_t)(h >> 32) & mask;
+    }
+
+    void rehash(size_t new_capacity) {
+        Slot* old_slots = slots;
+        size_t old_capacity = slots ? mask + 1 : 0;
+
+        slots = (Slot*)Luna::Memory::allocate(new_capacity * sizeof(Slot));
+        Luna::Memory::set(slots, 0, new_capacity * sizeof(Slot));
+        mask = new_capacity - 1;
+
+        for (size_t i = 0; i < old_capacity; i++) {
+            if (old_slots[i].count == 0) continue;
+            size_t pos = home(old_slots[i].key);
+            while (slots[pos].count != 0) pos = (pos + 1) & mask;
+            slots[pos] = old_slots[i];
+        }
+        Luna::Memory::deallocate(old_slots);
+    }
+
+    size_t find(void* key) const {
+        size_t pos = home(key);
+        while (slots[pos].count != 0) {
+            if (slots[pos].key == key) return pos;
+            pos = (pos + 1) & mask;
+        }
+        return (size_t)-1;
+    }
+
+public:
+    PointerIndex(size_t expected) : slots(nullptr), mask(0), size(0) {
+        size_t capacity = 16;
+        while (capacity < expected * 2) capacity <<= 1;
+        rehash(capacity);
+    }
+
+    ~PointerIndex() {
+        Luna::Memory::deallocate(slots);
+    }
+
+    bool contains(void* key) const {
+        return find(key) != (size_t)-1;
+    }
+
+    void add(void* key) {
+        // Keep load at or below one half
+        if ((size + 1) * 2 > mask + 1) rehash((mask + 1) * 2);
+
+        size_t pos = home(key);
+        while (slots[pos].count != 0) {
+            if (slots[pos].key == key) {
+                slots[pos].count++;
+                return;
+            }
+            pos = (pos + 1) & mask;
+        }
+        slots[pos].key = key;
+        slots[pos].count = 1;
+        size++;
+    }
+
+    void remove(void* key) {
+        size_t pos = find(key);
+        if (pos == (size_t)-1) return;
+        if (--slots[pos].count != 0) return;
+
+        // Pull later members of the probe run back over the hole
+        size_t hole = pos;
+        size_t next = (hole + 1) & mask;
+        while (slots[next].count != 0) {
+            size_t ideal = home(slots[next].key);
+            // Move if ideal position is not inside (hole, next]
+            if (((next - ideal) & mask) >= ((next - hole) & mask)) {
+                slots[hole] = slots[next];
+                hole = next;
+            }
+            next = (next + 1) & mask;
+        }
+        slots[hole].count = 0;
+        size--;
+    }
+
+    void clear() {
+        Luna::Memory::set(slots, 0, (mask + 1) * sizeof(Slot));
+        size = 0;
+    }
+};
+
+// ===== STRING SORTING =====
+
+typedef Luna::std::string LunaString;
+
+/**
+ * @brief Byte at depth as 1..256, or 0 past the end (so shorter strings sort first)
+ */
+static inline int keyByte(void* item, size_t depth) {
+    const LunaString* s = (const LunaString*)item;
+    return depth < s->length() ? (int)(unsigned char)s->c_str()[depth] + 1 : 0;
+}
+
+/**
+ * @brief Compare two strings from depth onward by unsigned bytes
+ */
+static int compareFrom(void* a, void* b, size_t depth) {
+    const LunaString* left = (const LunaString*)a;
+    const LunaString* right = (const LunaString*)b;
+    size_t left_length = left->length();
+    size_t right_length = right->length();
+    const unsigned char* l = (const unsigned char*)left->c_str();
+    const unsigned char* r = (const unsigned char*)right->c_str();
+
+    size_t shared = left_length < right_length ? left_length : right_length;
+    for (size_t i = depth; i < shared; i++) {
+        if (l[i] != r[i]) return l[i] < r[i] ? -1 : 1;
+    }
+    if (left_length == right_length) return 0;
+    return left_length < right_length ? -1 : 1;
 }
 
-Array::Array(size_t initial_capacity) : capacity(initial_capacity), length(0) {
+/**
+ * @brief Bentley-Sedgewick multikey quicksort: 3-way partition on one byte,
+ *        then only the equal band advances to the next byte
+ */
+static void multikeySort(void** items, size_t count, size_t depth) {
+    while (count > 1) {
+        if (count < 16) {
+            for (size_t i = 1; i < count; i++) {
+                void* item = items[i];
+                size_t j = i;
+                while (j > 0 && compareFrom(item, items[j - 1], depth) < 0) {
+                    items[j] = items[j - 1];
+                    j--;
+                }
+                items[j] = item;
+            }
+            return;
+        }
+
+        // Median-of-3 pivot byte
+        int a = keyByte(items[0], depth);
+        int b = keyByte(items[count / 2], depth);
+        int c = keyByte(items[count - 1], depth);
+        int pivot = a < b ? (b < c ? b : (a < c ? c : a)) : (a < c ? a : (b < c ? c : b));
+
+        // Dijkstra partition into [< pivot | == pivot | > pivot]
+        size_t lt = 0, i = 0, gt = count;
+        while (i < gt) {
+            int key = keyByte(items[i], depth);
+            if (key < pivot) {
+                void* temp = items[lt]; items[lt++] = items[i]; items[i++] = temp;
+            } else if (key > pivot) {
+                void* temp = items[--gt]; items[gt] = items[i]; items[i] = temp;
+            } else {
+                i++;
+            }
+        }
+
+        multikeySort(items, lt, depth);
+        multikeySort(items + gt, count - gt, depth);
+
+        // Equal band: strings that ended here are fully equal
+        if (pivot == 0) return;
+        items += lt;
+        count = gt - lt;
+        depth++;
+    }
+}
+
+// ===== ARRAY =====
+
+Array::Array()
+    : data(nullptr), capacity(0), length(0), inline_data(nullptr), inline_capacity(0),
+      membership(nullptr), deleter(nullptr) {}
+
+Array::Array(size_t initial_capacity)
+    : capacity(initial_capacity), length(0), inline_data(nullptr), inline_capacity(0),
+      membership(nullptr), deleter(nullptr) {
     if (capacity < 1) capacity = 1;
     data = (void**)Luna::Memory::allocate(capacity * sizeof(void*));
-    Luna::Memory::set(data, 0, capacity * sizeof(void*));
 }
 
+Array::Array(void** buffer, size_t buffer_capacity)
+    : data(buffer), capacity(buffer_capacity), length(0),
+      inline_data(buffer), inline_capacity(buffer_capacity), membership(nullptr), deleter(nullptr) {}
+
 Array::~Array() {
-    if (data) {
-        Luna::Memory::deallocate(data);
+    release();
+}
+
+Array::Array(const Array& other)
+    : data(nullptr), capacity(0), length(0), inline_data(nullptr), inline_capacity(0),
+      membership(nullptr), deleter(nullptr) {
+    pushAll((const void* const*)other.data, other.length);
+}
+
+Array& Array::operator=(const Array& other) {
+    if (this != &other) {
+        release();
+        pushAll((const void* const*)other.data, other.length);
+    }
+    return *this;
+}
+
+Array::Array(Array&& other)
+    : data(nullptr), capacity(0), length(0), inline_data(nullptr), inline_capacity(0),
+      membership(nullptr), deleter(nullptr) {
+    adopt(other);
+}
+
+Array& Array::operator=(Array&& other) {
+    if (this != &other) {
+        release();
+        adopt(other);
     }
+    return *this;
+}
+
+void Array::swap(Array& other) {
+    if (this == &other) return;
+    if (isInline() || other.isInline()) {
+        // Inline buffers stay with their owners, so go through moves
+        Array temp(static_cast<Array&&>(other));
+        other = static_cast<Array&&>(*this);
+        *this = static_cast<Array&&>(temp);
+        return;
+    }
+    
+    void** other_data = other.data;
+    size_t other_capacity = other.capacity;
+    size_t other_length = other.length;
+    PointerIndex* other_membership = other.membership;
+    Deleter other_deleter = other.deleter;
+    
+    other.data = data;
+    other.capacity = capacity;
+    other.length = length;
+    other.membership = membership;
+    other.deleter = deleter;
+    
+    data = other_data;
+    capacity = other_capacity;
+    length = other_length;
+    membership = other_membership;
+    deleter = other_deleter;
+}
+
+void Array::setDeleter(Deleter new_deleter) {
+    deleter = new_deleter;
 }
 
 void* Array::get(size_t index) const {
@@ -25,17 +337,25 @@ void* Array::get(size_t index) const {
 
 void Array::set(size_t index, void* value) {
     if (index >= length) return;
+    if (deleter && data[index] != value) deleter(data[index]);
+    if (membership) {
+        membership->remove(data[index]);
+        membership->add(value);
+    }
     data[index] = value;
 }
 
 void Array::push(void* value) {
     resizeIfNeeded();
     data[length++] = value;
+    if (membership) membership->add(value);
 }
 
 void* Array::pop() {
     if (length == 0) return nullptr;
-    return data[--length];
+    void* value = data[--length];
+    if (membership) membership->remove(value);
+    return value;
 }
 
 void Array::insert(size_t index, void* value) {
@@ -43,13 +363,12 @@ void Array::insert(size_t index, void* value) {
     
     resizeIfNeeded();
     
-    // Shift elements to the right
-    for (size_t i = length; i > index; i--) {
-        data[i] = data[i - 1];
-    }
+    // Shift the tail right with one block move
+    Luna::Memory::move(data + index + 1, data + index, (length - index) * sizeof(void*));
     
     data[index] = value;
     length++;
+    if (membership) membership->add(value);
 }
 
 void* Array::remove(size_t index) {
@@ -57,14 +376,13 @@ void* Array::remove(size_t index) {
     
     void* removed = data[index];
     
-    // Shift elements to the left
-    for (size_t i = index; i < length - 1; i++) {
-        data[i] = data[i + 1];
-    }
+    // Shift the tail left with one block move
+    Luna::Memory::move(data + index, data + index + 1, (length - index - 1) * sizeof(void*));
     
     length--;
     data[length] = nullptr; // Clear last element
     
+    if (membership) membership->remove(removed);
     return removed;
 }
 
@@ -81,38 +399,402 @@ bool Array::isEmpty() const {
 }
 
 void Array::clear() {
+    dropRange(0, length);
+    // Slots past length are never read, so there is nothing to zero
     length = 0;
-    // Optional: zero out the array
-    Luna::Memory::set(data, 0, capacity * sizeof(void*));
+    if (membership) membership->clear();
+}
+
+void Array::reserve(size_t n) {
+    if (n > capacity) {
+        reallocateExact(n);
+    }
+}
+
+void Array::shrinkToFit() {
+    size_t target = length ? length : 1;
+    if (target < capacity) {
+        reallocateExact(target);
+    }
+}
+
+void Array::resize(size_t n) {
+    if (n > capacity) {
+        grow(n);
+    }
+    if (n > length) {
+        Luna::Memory::set(data + length, 0, (n - length) * sizeof(void*));
+    } else {
+        dropRange(n, length);
+    }
+    length = n;
+    rebuildIndex();
+}
+
+void Array::pushAll(const void* const* items, size_t count) {
+    if (!items || count == 0) return;
+    
+    if (length + count > capacity) {
+        // items may point into our own buffer, which grow() frees
+        bool aliased = items >= (const void* const*)data && items < (const void* const*)(data + capacity);
+        size_t offset = aliased ? (size_t)(items - (const void* const*)data) : 0;
+        grow(length + count);
+        if (aliased) items = (const void* const*)data + offset;
+    }
+    
+    Luna::Memory::copy(data + length, items, count * sizeof(void*));
+    if (membership) {
+        for (size_t i = length; i < length + count; i++) membership->add(data[i]);
+    }
+    length += count;
 }
 
-int Array::indexOf(void* value) const {
-    for (size_t i = 0; i < length; i++) {
-        if (data[i] == value) {
-            return (int)i;
+void Array::extend(const Array& other) {
+    pushAll((const void* const*)other.data, other.length);
+}
+
+void Array::insertAll(size_t index, const void* const* items, size_t count) {
+    replaceRange(index, 0, items, count);
+}
+
+void Array::removeRange(size_t start, size_t count) {
+    if (start > length) start = length;
+    if (count > length - start) count = length - start;
+    dropRange(start, start + count);
+    replaceRange(start, count, nullptr, 0);
+}
+
+Array* Array::splice(size_t start, size_t delete_count, const void* const* items, size_t item_count) {
+    if (start > length) start = length;
+    if (delete_count > length - start) delete_count = length - start;
+    
+    Array* removed = new Array(delete_count);
+    removed->pushAll((const void* const*)(data + start), delete_count);
+    removed->deleter = deleter;
+    
+    replaceRange(start, delete_count, items, item_count);
+    return removed;
+}
+
+Array* Array::slice(size_t begin, size_t end) const {
+    if (end > length) end = length;
+    if (begin > end) begin = end;
+    
+    Array* result = new Array(end - begin);
+    result->pushAll((const void* const*)(data + begin), end - begin);
+    return result;
+}
+
+Array* Array::concat(const Array& other) const {
+    Array* result = new Array(length + other.length);
+    result->pushAll((const void* const*)data, length);
+    result->pushAll((const void* const*)other.data, other.length);
+    return result;
+}
+
+void Array::fill(void* value, size_t start, size_t end) {
+    if (end > length) end = length;
+    for (size_t i = start; i < end; i++) {
+        if (membership) {
+            membership->remove(data[i]);
+            membership->add(value);
         }
+        data[i] = value;
+    }
+}
+
+void Array::copyWithin(size_t target, size_t start, size_t end) {
+    if (end > length) end = length;
+    if (target >= length || start >= end) return;
+    
+    size_t count = end - start;
+    if (count > length - target) count = length - target;
+    
+    Luna::Memory::move(data + target, data + start, count * sizeof(void*));
+    rebuildIndex();
+}
+
+void Array::reverse() {
+    if (length < 2) return;
+    
+    void** left = data;
+    void** right = data + length - 1;
+    while (left < right) {
+        void* temp = *left;
+        *left++ = *right;
+        *right-- = temp;
     }
-    return -1;
+}
+
+size_t Array::indexOf(void* value) const {
+    if (membership && !membership->contains(value)) return npos;
+    
+    if (Luna::Cpu::hasAvx512()) return findPointerAvx512(data, length, value);
+    if (Luna::Cpu::hasAvx2()) return findPointerAvx2(data, length, value);
+    return findPointerSse2(data, length, value);
 }
 
 bool Array::contains(void* value) const {
-    return indexOf(value) != -1;
+    if (membership) return membership->contains(value);
+    return indexOf(value) != npos;
+}
+
+void Array::enableIndex() {
+    if (membership) return;
+    membership = new PointerIndex(length);
+    for (size_t i = 0; i < length; i++) membership->add(data[i]);
+}
+
+void Array::disableIndex() {
+    delete membership;
+    membership = nullptr;
+}
+
+bool Array::hasIndex() const {
+    return membership != nullptr;
+}
+
+void Array::sort(Comparator compare, bool stable) {
+    if (!compare) return;
+    
+    struct Less {
+        Comparator compare;
+        bool operator()(void* a, void* b) const { return compare(a, b) < 0; }
+    } less = { compare };
+    
+    if (stable) {
+        Luna::Sort::mergeSort(data, length, less);
+    } else {
+        Luna::Sort::pdqsort(data, length, less);
+    }
+}
+
+/**
+ * @brief Merge sorted src[begin, mid) and src[mid, end) into dst; ties take the left run
+ */
+static void mergeRuns(void** src, void** dst, size_t begin, size_t mid, size_t end, Array::Comparator compare) {
+    size_t left = begin, right = mid, out = begin;
+    while (left < mid && right < end) {
+        if (compare(src[right], src[left]) < 0) {
+            dst[out++] = src[right++];
+        } else {
+            dst[out++] = src[left++];
+        }
+    }
+    Luna::Memory::copy(dst + out, src + left, (mid - left) * sizeof(void*));
+    out += mid - left;
+    Luna::Memory::copy(dst + out, src + right, (end - right) * sizeof(void*));
+}
+
+void Array::parallelSort(Comparator compare, bool stable, size_t grain) {
+    if (!compare) return;
+    
+    size_t threads = Luna::Parallel::concurrency();
+    if (grain == 0) {
+        grain = length / (threads * 4);
+        if (grain < 4096) grain = 4096;
+    }
+    if (threads == 1 || length <= grain) {
+        sort(compare, stable);
+        return;
+    }
+    
+    struct SortContext { void** data; size_t length; size_t grain; Comparator compare; bool stable; };
+    SortContext sort_context = { data, length, grain, compare, stable };
+    size_t runs = (length + grain - 1) / grain;
+    
+    Luna::Parallel::forRange(runs, 1, [](void* raw, size_t begin, size_t end) {
+        SortContext* c = (SortContext*)raw;
+        struct Less {
+            Comparator compare;
+            bool operator()(void* a, void* b) const { return compare(a, b) < 0; }
+        } less = { c->compare };
+        for (size_t run = begin; run < end; run++) {
+            size_t first = run * c->grain;
+            size_t count = first + c->grain < c->length ? c->grain : c->length - first;
+            if (c->stable) {
+                Luna::Sort::mergeSort(c->data + first, count, less);
+            } else {
+                Luna::Sort::pdqsort(c->data + first, count, less);
+            }
+        }
+    }, &sort_context);
+    
+    // Each round merges neighbouring runs of width into runs of 2 * width
+    void** buffer = (void**)Luna::Memory::allocate(length * sizeof(void*));
+    struct MergeContext { void** src; void** dst; size_t length; size_t width; Comparator compare; };
+    MergeContext merge_context = { data, buffer, length, grain, compare };
+    
+    while (merge_context.width < length) {
+        size_t pairs = (length + 2 * merge_context.width - 1) / (2 * merge_context.width);
+        Luna::Parallel::forRange(pairs, 1, [](void* raw, size_t begin, size_t end) {
+            MergeContext* c = (MergeContext*)raw;
+            for (size_t pair = begin; pair < end; pair++) {
+                size_t first = pair * 2 * c->width;
+                size_t mid = first + c->width < c->length ? first + c->width : c->length;
+                size_t last = mid + c->width < c->length ? mid + c->width : c->length;
+                mergeRuns(c->src, c->dst, first, mid, last, c->compare);
+            }
+        }, &merge_context);
+        
+        void** temp = merge_context.src;
+        merge_context.src = merge_context.dst;
+        merge_context.dst = temp;
+        merge_context.width *= 2;
+    }
+    
+    if (merge_context.src != data) {
+        Luna::Memory::copy(data, merge_context.src, length * sizeof(void*));
+    }
+    Luna::Memory::deallocate(buffer);
+}
+
+void Array::sortNumbers() {
+    if (length < 2) return;
+    
+    // All-integer arrays only need 32-bit keys (at most 4 passes)
+    bool all_int = true;
+    for (size_t i = 0; i < length && all_int; i++) {
+        all_int = ((Number*)data[i])->isInt();
+    }
+    
+    if (all_int) {
+        uint32_t* keys = (uint32_t*)Luna::Memory::allocate(length * sizeof(uint32_t));
+        for (size_t i = 0; i < length; i++) {
+            keys[i] = Luna::Sort::int32Key(((Number*)data[i])->toInt());
+        }
+        Luna::Sort::radixSort(keys, data, length);
+        Luna::Memory::deallocate(keys);
+    } else {
+        uint64_t* keys = (uint64_t*)Luna::Memory::allocate(length * sizeof(uint64_t));
+        for (size_t i = 0; i < length; i++) {
+            keys[i] = Luna::Sort::doubleKey(((Number*)data[i])->toDouble());
+        }
+        Luna::Sort::radixSort(keys, data, length);
+        Luna::Memory::deallocate(keys);
+    }
+}
+
+void Array::sortStrings(bool stable) {
+    if (stable) {
+        struct Less {
+            bool operator()(void* a, void* b) const { return compareFrom(a, b, 0) < 0; }
+        } less;
+        Luna::Sort::mergeSort(data, length, less);
+    } else {
+        multikeySort(data, length, 0);
+    }
+}
+
+void Array::rebuildIndex() {
+    if (!membership) return;
+    membership->clear();
+    for (size_t i = 0; i < length; i++) membership->add(data[i]);
+}
+
+void Array::dropRange(size_t start, size_t end) {
+    if (!deleter) return;
+    for (size_t i = start; i < end; i++) deleter(data[i]);
+}
+
+void Array::release() {
+    dropRange(0, length);
+    delete membership;
+    membership = nullptr;
+    deleter = nullptr;
+    if (data && data != inline_data) {
+        Luna::Memory::deallocate(data);
+    }
+    data = inline_data;
+    capacity = inline_capacity;
+    length = 0;
+}
+
+void Array::adopt(Array& other) {
+    if (other.isInline()) {
+        // The inline buffer belongs to other: copy the elements out
+        pushAll((const void* const*)other.data, other.length);
+    } else {
+        data = other.data;
+        capacity = other.capacity;
+        length = other.length;
+    }
+    membership = other.membership;
+    deleter = other.deleter;
+    
+    other.data = other.inline_data;
+    other.capacity = other.inline_capacity;
+    other.length = 0;
+    other.membership = nullptr;
+    other.deleter = nullptr;
+}
+
+bool Array::isInline() const {
+    return data != nullptr && data == inline_data;
 }
 
 void Array::resizeIfNeeded() {
     if (length < capacity) return;
+    grow(length + 1);
+}
+
+void Array::grow(size_t min_capacity) {
+    size_t new_capacity = capacity ? capacity * 2 : 8;
+    if (new_capacity < min_capacity) new_capacity = min_capacity;
+    reallocateExact(new_capacity);
+}
+
+void Array::replaceRange(size_t start, size_t delete_count, const void* const* items, size_t item_count) {
+    if (start > length) start = length;
+    if (delete_count > length - start) delete_count = length - start;
+    if (!items) item_count = 0;
     
-    size_t new_capacity = capacity * 2;
-    void** new_data = (void**)Luna::Memory::allocate(new_capacity * sizeof(void*));
+    // Items inside our own buffer would be overwritten by the move below
+    void** staged = nullptr;
+    if (item_count > 0 && items >= (const void* const*)data && items < (const void* const*)(data + capacity)) {
+        staged = (void**)Luna::Memory::allocate(item_count * sizeof(void*));
+        Luna::Memory::copy(staged, items, item_count * sizeof(void*));
+        items = (const void* const*)staged;
+    }
     
-    // Copy existing data
-    Luna::Memory::copy(new_data, data, length * sizeof(void*));
+    size_t new_length = length - delete_count + item_count;
+    if (new_length > capacity) {
+        grow(new_length);
+    }
+    
+    if (membership) {
+        for (size_t i = start; i < start + delete_count; i++) membership->remove(data[i]);
+        for (size_t i = 0; i < item_count; i++) membership->add((void*)items[i]);
+    }
+    
+    // Close or open the gap with one block move
+    size_t tail = length - start - delete_count;
+    Luna::Memory::move(data + start + item_count, data + start + delete_count, tail * sizeof(void*));
+    Luna::Memory::copy(data + start, items, item_count * sizeof(void*));
+    length = new_length;
+    
+    if (staged) {
+        Luna::Memory::deallocate(staged);
+    }
+}
+
+void Array::reallocateExact(size_t new_capacity) {
+    void** new_data;
+    if (inline_data && new_capacity <= inline_capacity) {
+        // Fits the inline buffer again; never shrink below it
+        if (data == inline_data) return;
+        new_data = inline_data;
+        new_capacity = inline_capacity;
+    } else {
+        new_data = (void**)Luna::Memory::allocate(new_capacity * sizeof(void*));
+    }
     
-    // Zero out the rest
-    Luna::Memory::set(new_data + length, 0, (new_capacity - length) * sizeof(void*));
+    // Only live elements are copied; slots past length are never read
+    Luna::Memory::copy(new_data, data, length * sizeof(void*));
     
-    // Replace old data
-    Luna::Memory::deallocate(data);
+    if (data != inline_data) {
+        Luna::Memory::deallocate(data);
+    }
     data = new_data;
     capacity = new_capacity;
 }
\ No newline at end of file
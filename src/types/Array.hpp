@@ -1,16 +1,39 @@
 #pragma once
 
 #include "lib/memory.hpp"
+#include "lib/parallel.hpp"
+
+class PointerIndex;
+class LazySource;
+template<typename Stage> class LazyArray;
 
 class Array {
+    friend class LazySource;
+
 private:
     void** data;
     size_t capacity;
     size_t length;
+    void** inline_data;
+    size_t inline_capacity;
+    PointerIndex* membership;
+    void (*deleter)(void* element);
 
 public:
+    static const size_t npos = (size_t)-1;
+
+    /**
+     * @brief Element ordering: negative if a sorts first, 0 if equal, positive otherwise
+     */
+    typedef int (*Comparator)(void* a, void* b);
+
+    /**
+     * @brief Frees one element of an owning array
+     */
+    typedef void (*Deleter)(void* element);
+
     /**
-     * @brief Construct empty array
+     * @brief Construct empty array (allocates on first push)
      */
     Array();
     
@@ -20,10 +43,27 @@ public:
     Array(size_t initial_capacity);
     
     /**
-     * @brief Destroy array and free memory
+     * @brief Destroy array and free memory (and owned elements)
      */
     ~Array();
     
+    /**
+     * @brief Copy element pointers; the copy does not own them
+     */
+    Array(const Array& other);
+    Array& operator=(const Array& other);
+    
+    /**
+     * @brief Take other's storage, index and deleter, leaving other empty
+     */
+    Array(Array&& other);
+    Array& operator=(Array&& other);
+    
+    /**
+     * @brief Exchange contents with other (O(1) unless either is inline)
+     */
+    void swap(Array& other);
+    
     /**
      * @brief Get element at index
      */
@@ -75,18 +115,571 @@ public:
     void clear();
     
     /**
-     * @brief Find index of element
+     * @brief Ensure capacity for at least n elements
+     */
+    void reserve(size_t n);
+    
+    /**
+     * @brief Release unused capacity
+     */
+    void shrinkToFit();
+    
+    /**
+     * @brief Set length to n (new slots are nullptr)
+     */
+    void resize(size_t n);
+    
+    /**
+     * @brief Append count elements in one block copy
+     */
+    void pushAll(const void* const* items, size_t count);
+    
+    /**
+     * @brief Append all elements of another array
+     */
+    void extend(const Array& other);
+    
+    // ===== BULK OPERATIONS =====
+    // Indices are clamped to the array like their JS counterparts
+    
+    /**
+     * @brief Insert count elements at index with one block move
+     */
+    void insertAll(size_t index, const void* const* items, size_t count);
+    
+    /**
+     * @brief Remove count elements starting at start with one block move
+     */
+    void removeRange(size_t start, size_t count);
+    
+    /**
+     * @brief Remove delete_count elements at start and insert items there
+     * @returns Array of removed elements (caller manages memory)
+     */
+    Array* splice(size_t start, size_t delete_count, const void* const* items = nullptr, size_t item_count = 0);
+    
+    /**
+     * @brief Copy of elements in [begin, end) (caller manages memory)
+     */
+    Array* slice(size_t begin = 0, size_t end = npos) const;
+    
+    /**
+     * @brief New array of this followed by other (caller manages memory)
+     */
+    Array* concat(const Array& other) const;
+    
+    /**
+     * @brief Set elements in [start, end) to value
+     */
+    void fill(void* value, size_t start = 0, size_t end = npos);
+    
+    /**
+     * @brief Copy elements in [start, end) to target, overlap-safe
+     */
+    void copyWithin(size_t target, size_t start, size_t end = npos);
+    
+    /**
+     * @brief Reverse elements in place
      */
-    int indexOf(void* value) const;
+    void reverse();
     
     /**
-     * @brief Check if array contains element
+     * @brief Find index of element (vectorized pointer compare), or npos
+     */
+    size_t indexOf(void* value) const;
+    
+    /**
+     * @brief Check if array contains element (O(1) with an index)
      */
     bool contains(void* value) const;
+    
+    /**
+     * @brief Build a hash index of elements, kept current on every mutation
+     */
+    void enableIndex();
+    
+    /**
+     * @brief Drop the hash index
+     */
+    void disableIndex();
+    
+    /**
+     * @brief Check if a hash index is active
+     */
+    bool hasIndex() const;
+    
+    // ===== SORTING =====
+    
+    /**
+     * @brief Sort with comparator (pdqsort, or merge sort when stable)
+     */
+    void sort(Comparator compare, bool stable = false);
+    
+    /**
+     * @brief Sort Number* elements ascending by LSD radix sort (stable, NaN last)
+     */
+    void sortNumbers();
+    
+    /**
+     * @brief Sort Luna::std::string* elements by bytes (multikey quicksort, or merge sort when stable)
+     */
+    void sortStrings(bool stable = false);
+    
+    // ===== ITERATION =====
+    // Callbacks take (void* value, size_t index) like their JS counterparts.
+    // Elements appended during a call are not visited.
+    
+    /**
+     * @brief Call fn(value, index) for every element
+     */
+    template<typename Fn>
+    void forEach(Fn fn) const {
+        size_t count = length;
+        for (size_t i = 0; i < count && i < length; i++) fn(data[i], i);
+    }
+    
+    /**
+     * @brief New array of fn(value, index) results (caller manages memory)
+     */
+    template<typename Fn>
+    Array* map(Fn fn) const {
+        size_t count = length;
+        Array* result = new Array(count);
+        for (size_t i = 0; i < count && i < length; i++) result->push(fn(data[i], i));
+        return result;
+    }
+    
+    /**
+     * @brief New array of elements where fn(value, index) is true (caller manages memory)
+     */
+    template<typename Fn>
+    Array* filter(Fn fn) const {
+        size_t count = length;
+        Array* result = new Array();
+        for (size_t i = 0; i < count && i < length; i++) {
+            if (fn(data[i], i)) result->push(data[i]);
+        }
+        return result;
+    }
+    
+    /**
+     * @brief Fold elements left to right: acc = fn(acc, value, index)
+     */
+    template<typename Fn, typename Acc>
+    Acc reduce(Fn fn, Acc initial) const {
+        size_t count = length;
+        for (size_t i = 0; i < count && i < length; i++) initial = fn(initial, data[i], i);
+        return initial;
+    }
+    
+    /**
+     * @brief Check if fn(value, index) is true for any element (stops at first)
+     */
+    template<typename Fn>
+    bool some(Fn fn) const {
+        return findIndex(fn) != npos;
+    }
+    
+    /**
+     * @brief Check if fn(value, index) is true for every element (stops at first failure)
+     */
+    template<typename Fn>
+    bool every(Fn fn) const {
+        size_t count = length;
+        for (size_t i = 0; i < count && i < length; i++) {
+            if (!fn(data[i], i)) return false;
+        }
+        return true;
+    }
+    
+    /**
+     * @brief First element where fn(value, index) is true, or nullptr
+     */
+    template<typename Fn>
+    void* find(Fn fn) const {
+        size_t found = findIndex(fn);
+        return found == npos ? nullptr : data[found];
+    }
+    
+    /**
+     * @brief Index of first element where fn(value, index) is true, or npos
+     */
+    template<typename Fn>
+    size_t findIndex(Fn fn) const {
+        size_t count = length;
+        for (size_t i = 0; i < count && i < length; i++) {
+            if (fn(data[i], i)) return i;
+        }
+        return npos;
+    }
+    
+    /**
+     * @brief Start a fused pipeline: stages run in one pass with no intermediate arrays
+     */
+    LazyArray<LazySource> lazy() const;
+    
+    // ===== PARALLEL ALGORITHMS =====
+    // Run on the Luna::Parallel work-stealing pool. fn must be safe to call
+    // concurrently, and the array must not change while they run.
+    // grain 0 lets the pool choose a piece size.
+    
+    /**
+     * @brief Call fn(value, index) for every element, in parallel
+     */
+    template<typename Fn>
+    void parallelForEach(Fn fn, size_t grain = 0) const {
+        struct Context { const Array* self; Fn* fn; } context = { this, &fn };
+        Luna::Parallel::forRange(length, grain, [](void* raw, size_t begin, size_t end) {
+            Context* c = (Context*)raw;
+            for (size_t i = begin; i < end; i++) (*c->fn)(c->self->data[i], i);
+        }, &context);
+    }
+    
+    /**
+     * @brief New array of fn(value, index) results, computed in parallel (caller manages memory)
+     */
+    template<typename Fn>
+    Array* parallelMap(Fn fn, size_t grain = 0) const {
+        Array* result = new Array(length);
+        result->length = length;
+        struct Context { const Array* self; Array* result; Fn* fn; } context = { this, result, &fn };
+        Luna::Parallel::forRange(length, grain, [](void* raw, size_t begin, size_t end) {
+            Context* c = (Context*)raw;
+            for (size_t i = begin; i < end; i++) c->result->data[i] = (*c->fn)(c->self->data[i], i);
+        }, &context);
+        return result;
+    }
+    
+    /**
+     * @brief Parallel fold: each grain-sized chunk folds from identity with
+     *        acc = fn(acc, value, index), then chunks combine left to right
+     *
+     * Chunk boundaries depend only on length and grain, so the result is
+     * the same for any thread count or schedule.
+     */
+    template<typename Fn, typename Combine, typename Acc>
+    Acc parallelReduce(Fn fn, Combine combine, Acc identity, size_t grain = 0) const {
+        static_assert(__is_trivially_copyable(Acc), "parallelReduce needs a trivially copyable accumulator");
+        if (grain == 0) grain = Luna::Parallel::DEFAULT_REDUCE_GRAIN;
+        size_t chunks = (length + grain - 1) / grain;
+        if (chunks == 0) return identity;
+        
+        Acc* partials = (Acc*)Luna::Memory::allocate(chunks * sizeof(Acc));
+        struct Context {
+            const Array* self; Fn* fn; Acc* partials; const Acc* identity; size_t grain;
+        } context = { this, &fn, partials, &identity, grain };
+        
+        Luna::Parallel::forRange(chunks, 1, [](void* raw, size_t begin, size_t end) {
+            Context* c = (Context*)raw;
+            for (size_t chunk = begin; chunk < end; chunk++) {
+                size_t first = chunk * c->grain;
+                size_t last = first + c->grain < c->self->length ? first + c->grain : c->self->length;
+                Acc acc = *c->identity;
+                for (size_t i = first; i < last; i++) acc = (*c->fn)(acc, c->self->data[i], i);
+                c->partials[chunk] = acc;
+            }
+        }, &context);
+        
+        Acc result = identity;
+        for (size_t chunk = 0; chunk < chunks; chunk++) result = combine(result, partials[chunk]);
+        Luna::Memory::deallocate(partials);
+        return result;
+    }
+    
+    /**
+     * @brief Sort grain-sized runs in parallel, then merge them pairwise in parallel rounds
+     */
+    void parallelSort(Comparator compare, bool stable = false, size_t grain = 0);
+    
+    /**
+     * @brief Check if elements live in an inline buffer (see SmallArray)
+     */
+    bool isInline() const;
+    
+    // ===== ELEMENT OWNERSHIP =====
+    // An owning array runs its deleter on elements it drops: on clear(),
+    // set(), removeRange(), a shrinking resize() and destruction. Elements
+    // handed back by pop() and remove() become the caller's; splice()
+    // passes the deleter on to the array it returns. fill() and
+    // copyWithin() duplicate pointers and are not for owning arrays.
+    
+    /**
+     * @brief Own elements, freeing them with deleter (nullptr stops owning)
+     */
+    void setDeleter(Deleter deleter);
+    
+    /**
+     * @brief Get the deleter (nullptr when elements are not owned)
+     */
+    Deleter getDeleter() const { return deleter; }
+    
+    /**
+     * @brief Deleter for elements allocated with new T
+     */
+    template<typename T>
+    static void deleteAs(void* element) { delete (T*)element; }
+    
+    /**
+     * @brief Own elements allocated with new T
+     */
+    template<typename T>
+    void ownAs() { setDeleter(&deleteAs<T>); }
+
+protected:
+    /**
+     * @brief Construct array over a caller-owned buffer of buffer_capacity slots
+     */
+    Array(void** buffer, size_t buffer_capacity);
 
 private:
     /**
      * @brief Resize array if needed
      */
     void resizeIfNeeded();
-};
\ No newline at end of file
+    
+    /**
+     * @brief Grow to at least min_capacity (doubling), one block copy
+     */
+    void grow(size_t min_capacity);
+    
+    /**
+     * @brief Move storage to a block of exactly new_capacity elements
+     */
+    void reallocateExact(size_t new_capacity);
+    
+    /**
+     * @brief Recount the index after an in-place rewrite
+     */
+    void rebuildIndex();
+    
+    /**
+     * @brief Replace delete_count elements at start with items
+     */
+    void replaceRange(size_t start, size_t delete_count, const void* const* items, size_t item_count);
+    
+    /**
+     * @brief Run the deleter on elements in [start, end)
+     */
+    void dropRange(size_t start, size_t end);
+    
+    /**
+     * @brief Drop elements, index and heap storage, returning to the empty state
+     */
+    void release();
+    
+    /**
+     * @brief Take other's contents into this empty array, leaving other empty
+     */
+    void adopt(Array& other);
+};
+
+/**
+ * @brief Array keeping its first N elements inside the object
+ *
+ * Storage spills to the heap only when the array outgrows N, and moves
+ * back inline if shrinkToFit() brings it under N again.
+ */
+template<size_t N>
+class SmallArray : public Array {
+private:
+    void* slots[N];
+
+public:
+    SmallArray() : Array(slots, N) {}
+
+    SmallArray(const SmallArray&) = delete;
+    SmallArray& operator=(const SmallArray&) = delete;
+};
+
+// ===== LAZY PIPELINES =====
+// Each stage pushes values into the next through a sink callable that
+// returns false to stop early, so a chain compiles to a single loop.
+// Stage callbacks take (void* value, size_t index), where index is the
+// element's position in the source array.
+
+/**
+ * @brief Pipeline head: feeds the array's elements in order
+ */
+class LazySource {
+private:
+    const Array* array;
+
+public:
+    LazySource(const Array* array) : array(array) {}
+
+    template<typename Sink>
+    void run(Sink& sink) const {
+        size_t count = array->length;
+        for (size_t i = 0; i < count && i < array->length; i++) {
+            if (!sink(array->data[i], i)) return;
+        }
+    }
+};
+
+/**
+ * @brief Pipeline stage passing on values where fn(value, index) is true
+ */
+template<typename Prev, typename Fn>
+class LazyFilter {
+private:
+    Prev prev;
+    Fn fn;
+
+public:
+    LazyFilter(const Prev& prev, Fn fn) : prev(prev), fn(fn) {}
+
+    template<typename Sink>
+    void run(Sink& sink) const {
+        auto stage = [&](void* value, size_t index) -> bool {
+            return fn(value, index) ? sink(value, index) : true;
+        };
+        prev.run(stage);
+    }
+};
+
+/**
+ * @brief Pipeline stage passing on fn(value, index)
+ */
+template<typename Prev, typename Fn>
+class LazyMap {
+private:
+    Prev prev;
+    Fn fn;
+
+public:
+    LazyMap(const Prev& prev, Fn fn) : prev(prev), fn(fn) {}
+
+    template<typename Sink>
+    void run(Sink& sink) const {
+        auto stage = [&](void* value, size_t index) -> bool {
+            return sink(fn(value, index), index);
+        };
+        prev.run(stage);
+    }
+};
+
+/**
+ * @brief Lazy view over an Array; nothing runs until a terminal call
+ */
+template<typename Stage>
+class LazyArray {
+private:
+    Stage stage;
+
+public:
+    LazyArray(const Stage& stage) : stage(stage) {}
+
+    /**
+     * @brief Add a filter stage
+     */
+    template<typename Fn>
+    LazyArray<LazyFilter<Stage, Fn> > filter(Fn fn) const {
+        return LazyArray<LazyFilter<Stage, Fn> >(LazyFilter<Stage, Fn>(stage, fn));
+    }
+
+    /**
+     * @brief Add a map stage
+     */
+    template<typename Fn>
+    LazyArray<LazyMap<Stage, Fn> > map(Fn fn) const {
+        return LazyArray<LazyMap<Stage, Fn> >(LazyMap<Stage, Fn>(stage, fn));
+    }
+
+    /**
+     * @brief Run the pipeline, calling fn(value, index) on each result
+     */
+    template<typename Fn>
+    void forEach(Fn fn) const {
+        auto sink = [&](void* value, size_t index) -> bool {
+            fn(value, index);
+            return true;
+        };
+        stage.run(sink);
+    }
+
+    /**
+     * @brief Run the pipeline folding results: acc = fn(acc, value, index)
+     */
+    template<typename Fn, typename Acc>
+    Acc reduce(Fn fn, Acc initial) const {
+        auto sink = [&](void* value, size_t index) -> bool {
+            initial = fn(initial, value, index);
+            return true;
+        };
+        stage.run(sink);
+        return initial;
+    }
+
+    /**
+     * @brief First result where fn(value, index) is true, or nullptr (stops early)
+     */
+    template<typename Fn>
+    void* find(Fn fn) const {
+        void* found = nullptr;
+        auto sink = [&](void* value, size_t index) -> bool {
+            if (!fn(value, index)) return true;
+            found = value;
+            return false;
+        };
+        stage.run(sink);
+        return found;
+    }
+
+    /**
+     * @brief Check if fn(value, index) is true for any result (stops early)
+     */
+    template<typename Fn>
+    bool some(Fn fn) const {
+        bool result = false;
+        auto sink = [&](void* value, size_t index) -> bool {
+            result = fn(value, index);
+            return !result;
+        };
+        stage.run(sink);
+        return result;
+    }
+
+    /**
+     * @brief Check if fn(value, index) is true for every result (stops early)
+     */
+    template<typename Fn>
+    bool every(Fn fn) const {
+        bool result = true;
+        auto sink = [&](void* value, size_t index) -> bool {
+            result = fn(value, index);
+            return result;
+        };
+        stage.run(sink);
+        return result;
+    }
+
+    /**
+     * @brief Number of results
+     */
+    size_t count() const {
+        size_t total = 0;
+        auto sink = [&](void*, size_t) -> bool {
+            total++;
+            return true;
+        };
+        stage.run(sink);
+        return total;
+    }
+
+    /**
+     * @brief Collect results into a new array (caller manages memory)
+     */
+    Array* toArray() const {
+        Array* result = new Array();
+        auto sink = [&](void* value, size_t) -> bool {
+            result->push(value);
+            return true;
+        };
+        stage.run(sink);
+        return result;
+    }
+};
+
+inline LazyArray<LazySource> Array::lazy() const {
+    return LazyArray<LazySource>(LazySource(this));
+}
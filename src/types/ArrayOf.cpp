@@ -0,0 +1,7 @@
+#include "ArrayOf.hpp"
+
+// Numeric element types are instantiated here once; every other
+// translation unit sees them through the extern declarations.
+template class ArrayOf<double>;
+template class ArrayOf<int32_t>;
+template class ArrayOf<Number>;
@@ -0,0 +1,403 @@
+#pragma once
+
+#include "lib/memory.hpp"
+#include "types/Number.hpp"
+#include <new>
+
+/**
+ * @brief Element equality used by ArrayOf::indexOf
+ */
+template<typename T>
+struct ArrayOfTraits {
+    static bool equals(const T& a, const T& b) { return a == b; }
+};
+
+template<>
+struct ArrayOfTraits<Number> {
+    static bool equals(const Number& a, const Number& b) { return a.equals(b); }
+};
+
+/**
+ * @brief Array storing T inline and contiguously (no per-element allocation)
+ *
+ * Trivially copyable element types grow and shift with block copies;
+ * other types are move-constructed into the new storage.
+ */
+template<typename T>
+class ArrayOf {
+private:
+    T* items;
+    size_t capacity;
+    size_t length;
+
+    static const bool trivial = __is_trivially_copyable(T);
+
+public:
+    static const size_t npos = (size_t)-1;
+
+    /**
+     * @brief Construct empty array
+     */
+    ArrayOf() : items(nullptr), capacity(0), length(0) {}
+
+    /**
+     * @brief Construct array with initial capacity
+     */
+    ArrayOf(size_t initial_capacity) : items(nullptr), capacity(0), length(0) {
+        reserve(initial_capacity);
+    }
+
+    /**
+     * @brief Destroy elements and free memory
+     */
+    ~ArrayOf() {
+        destroyRange(0, length);
+        Luna::Memory::deallocate(items);
+    }
+
+    ArrayOf(const ArrayOf&) = delete;
+    ArrayOf& operator=(const ArrayOf&) = delete;
+
+    // ===== ELEMENT ACCESS =====
+
+    /**
+     * @brief Pointer to element at index, or nullptr if out of range
+     */
+    T* get(size_t index) { return index < length ? items + index : nullptr; }
+    const T* get(size_t index) const { return index < length ? items + index : nullptr; }
+
+    /**
+     * @brief Unchecked element access
+     */
+    T& operator[](size_t index) { return items[index]; }
+    const T& operator[](size_t index) const { return items[index]; }
+
+    /**
+     * @brief Set element at index
+     */
+    void set(size_t index, const T& value) {
+        if (index >= length) return;
+        items[index] = value;
+    }
+
+    /**
+     * @brief Contiguous element storage
+     */
+    T* getData() { return items; }
+    const T* getData() const { return items; }
+
+    T* begin() { return items; }
+    T* end() { return items + length; }
+    const T* begin() const { return items; }
+    const T* end() const { return items + length; }
+
+    // ===== MODIFICATION =====
+
+    /**
+     * @brief Append element to end
+     */
+    void push(const T& value) {
+        if (length == capacity) {
+            // value may live in our own storage
+            T copy(value);
+            grow(length + 1);
+            new (items + length) T(static_cast<T&&>(copy));
+        } else {
+            new (items + length) T(value);
+        }
+        length++;
+    }
+
+    void push(T&& value) {
+        if (length == capacity) {
+            T moved(static_cast<T&&>(value));
+            grow(length + 1);
+            new (items + length) T(static_cast<T&&>(moved));
+        } else {
+            new (items + length) T(static_cast<T&&>(value));
+        }
+        length++;
+    }
+
+    /**
+     * @brief Remove last element, moving it to out if given
+     * @returns false if array is empty
+     */
+    bool pop(T* out = nullptr) {
+        if (length == 0) return false;
+        length--;
+        if (out) *out = static_cast<T&&>(items[length]);
+        items[length].~T();
+        return true;
+    }
+
+    /**
+     * @brief Insert element at index
+     */
+    void insert(size_t index, const T& value) {
+        insertAll(index, &value, 1);
+    }
+
+    /**
+     * @brief Remove element at index, moving it to out if given
+     * @returns false if index is out of range
+     */
+    bool remove(size_t index, T* out = nullptr) {
+        if (index >= length) return false;
+        if (out) *out = static_cast<T&&>(items[index]);
+        removeRange(index, 1);
+        return true;
+    }
+
+    /**
+     * @brief Insert count elements at index
+     */
+    void insertAll(size_t index, const T* values, size_t count) {
+        if (index > length) index = length;
+        if (!values || count == 0) return;
+
+        // Stage values that live in our own storage before shifting
+        T* staged = nullptr;
+        if (values >= items && values < items + capacity) {
+            staged = (T*)Luna::Memory::allocate(count * sizeof(T));
+            for (size_t i = 0; i < count; i++) new (staged + i) T(values[i]);
+            values = staged;
+        }
+
+        if (length + count > capacity) grow(length + count);
+        shiftTail(index, index + count);
+        for (size_t i = 0; i < count; i++) new (items + index + i) T(values[i]);
+        length += count;
+
+        if (staged) {
+            for (size_t i = 0; i < count; i++) staged[i].~T();
+            Luna::Memory::deallocate(staged);
+        }
+    }
+
+    /**
+     * @brief Remove count elements starting at start
+     */
+    void removeRange(size_t start, size_t count) {
+        if (start >= length) return;
+        if (count > length - start) count = length - start;
+
+        destroyRange(start, start + count);
+        shiftTail(start + count, start);
+        length -= count;
+    }
+
+    /**
+     * @brief Remove delete_count elements at start and insert values there
+     * @returns Array of removed elements (caller manages memory)
+     */
+    ArrayOf* splice(size_t start, size_t delete_count, const T* values = nullptr, size_t count = 0) {
+        if (start > length) start = length;
+        if (delete_count > length - start) delete_count = length - start;
+
+        // Insert first: values may alias the elements being removed
+        insertAll(start, values, count);
+        ArrayOf* removed = new ArrayOf(delete_count);
+        for (size_t i = 0; i < delete_count; i++) removed->push(static_cast<T&&>(items[start + count + i]));
+        removeRange(start + count, delete_count);
+        return removed;
+    }
+
+    /**
+     * @brief Set elements in [start, end) to value
+     */
+    void fill(const T& value, size_t start = 0, size_t end = npos) {
+        if (end > length) end = length;
+        for (size_t i = start; i < end; i++) items[i] = value;
+    }
+
+    /**
+     * @brief Copy elements in [start, end) to target, overlap-safe
+     */
+    void copyWithin(size_t target, size_t start, size_t end = npos) {
+        if (end > length) end = length;
+        if (target >= length || start >= end) return;
+
+        size_t count = end - start;
+        if (count > length - target) count = length - target;
+
+        if (trivial) {
+            Luna::Memory::move(items + target, items + start, count * sizeof(T));
+        } else if (target < start) {
+            for (size_t i = 0; i < count; i++) items[target + i] = items[start + i];
+        } else {
+            for (size_t i = count; i > 0; i--) items[target + i - 1] = items[start + i - 1];
+        }
+    }
+
+    /**
+     * @brief Reverse elements in place
+     */
+    void reverse() {
+        if (length < 2) return;
+        for (size_t left = 0, right = length - 1; left < right; left++, right--) {
+            T temp(static_cast<T&&>(items[left]));
+            items[left] = static_cast<T&&>(items[right]);
+            items[right] = static_cast<T&&>(temp);
+        }
+    }
+
+    /**
+     * @brief Copy of elements in [begin, end) (caller manages memory)
+     */
+    ArrayOf* slice(size_t begin = 0, size_t end = npos) const {
+        if (end > length) end = length;
+        if (begin > end) begin = end;
+        ArrayOf* result = new ArrayOf(end - begin);
+        result->pushAll(items + begin, end - begin);
+        return result;
+    }
+
+    /**
+     * @brief New array of this followed by other (caller manages memory)
+     */
+    ArrayOf* concat(const ArrayOf& other) const {
+        ArrayOf* result = new ArrayOf(length + other.length);
+        result->pushAll(items, length);
+        result->pushAll(other.items, other.length);
+        return result;
+    }
+
+    // ===== CAPACITY =====
+
+    size_t getLength() const { return length; }
+    size_t getCapacity() const { return capacity; }
+    bool isEmpty() const { return length == 0; }
+
+    /**
+     * @brief Destroy all elements (capacity is kept)
+     */
+    void clear() {
+        destroyRange(0, length);
+        length = 0;
+    }
+
+    /**
+     * @brief Ensure capacity for at least n elements
+     */
+    void reserve(size_t n) {
+        if (n > capacity) reallocateExact(n);
+    }
+
+    /**
+     * @brief Release unused capacity
+     */
+    void shrinkToFit() {
+        if (length < capacity) reallocateExact(length);
+    }
+
+    /**
+     * @brief Set length to n, filling new slots with value
+     */
+    void resize(size_t n, const T& value) {
+        if (n < length) {
+            destroyRange(n, length);
+        } else if (n > length) {
+            if (n > capacity) {
+                T copy(value);
+                grow(n);
+                for (size_t i = length; i < n; i++) new (items + i) T(copy);
+            } else {
+                for (size_t i = length; i < n; i++) new (items + i) T(value);
+            }
+        }
+        length = n;
+    }
+
+    /**
+     * @brief Append count elements with one growth step
+     */
+    void pushAll(const T* values, size_t count) {
+        insertAll(length, values, count);
+    }
+
+    /**
+     * @brief Append all elements of another array
+     */
+    void extend(const ArrayOf& other) {
+        pushAll(other.items, other.length);
+    }
+
+    // ===== SEARCH =====
+
+    /**
+     * @brief Find index of element, or npos
+     */
+    size_t indexOf(const T& value) const {
+        for (size_t i = 0; i < length; i++) {
+            if (ArrayOfTraits<T>::equals(items[i], value)) return i;
+        }
+        return npos;
+    }
+
+    /**
+     * @brief Check if array contains element
+     */
+    bool contains(const T& value) const {
+        return indexOf(value) != npos;
+    }
+
+private:
+    void destroyRange(size_t start, size_t end) {
+        if (__has_trivial_destructor(T)) return;
+        for (size_t i = start; i < end; i++) items[i].~T();
+    }
+
+    /**
+     * @brief Move the elements from `from` to the end so they start at `to`
+     *
+     * Slots left behind are raw storage; slots overwritten must already be
+     * destroyed.
+     */
+    void shiftTail(size_t from, size_t to) {
+        size_t count = length - from;
+        if (count == 0 || from == to) return;
+
+        if (trivial) {
+            Luna::Memory::move(items + to, items + from, count * sizeof(T));
+        } else if (to > from) {
+            for (size_t i = count; i > 0; i--) {
+                new (items + to + i - 1) T(static_cast<T&&>(items[from + i - 1]));
+                items[from + i - 1].~T();
+            }
+        } else {
+            for (size_t i = 0; i < count; i++) {
+                new (items + to + i) T(static_cast<T&&>(items[from + i]));
+                items[from + i].~T();
+            }
+        }
+    }
+
+    void grow(size_t min_capacity) {
+        size_t new_capacity = capacity ? capacity * 2 : 4;
+        if (new_capacity < min_capacity) new_capacity = min_capacity;
+        reallocateExact(new_capacity);
+    }
+
+    void reallocateExact(size_t new_capacity) {
+        T* new_items = new_capacity ? (T*)Luna::Memory::allocate(new_capacity * sizeof(T)) : nullptr;
+
+        if (trivial) {
+            Luna::Memory::copy(new_items, items, length * sizeof(T));
+        } else {
+            for (size_t i = 0; i < length; i++) {
+                new (new_items + i) T(static_cast<T&&>(items[i]));
+                items[i].~T();
+            }
+        }
+
+        Luna::Memory::deallocate(items);
+        items = new_items;
+        capacity = new_capacity;
+    }
+};
+
+// Numeric instantiations are compiled once in ArrayOf.cpp
+extern template class ArrayOf<double>;
+extern template class ArrayOf<int32_t>;
+extern template class ArrayOf<Number>;
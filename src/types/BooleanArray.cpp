@@ -0,0 +1,259 @@
+#include "BooleanArray.hpp"
+#include "lib/memory.hpp"
+#include "lib/cpu.hpp"
+#include <immintrin.h>
+
+// ===== VECTOR KERNELS =====
+// Each kernel processes 4 words (256 bits) per step and leaves the
+// remainder to the scalar loop in the caller.
+
+__attribute__((target("avx2")))
+static size_t andWordsAvx2(uint64_t* dst, const uint64_t* src, size_t count) {
+    size_t i = 0;
+    for (; i + 4 <= count; i += 4) {
+        __m256i a = _mm256_loadu_si256((const __m256i*)(dst + i));
+        __m256i b = _mm256_loadu_si256((const __m256i*)(src + i));
+        _mm256_storeu_si256((__m256i*)(dst + i), _mm256_and_si256(a, b));
+    }
+    return i;
+}
+
+__attribute__((target("avx2")))
+static size_t orWordsAvx2(uint64_t* dst, const uint64_t* src, size_t count) {
+    size_t i = 0;
+    for (; i + 4 <= count; i += 4) {
+        __m256i a = _mm256_loadu_si256((const __m256i*)(dst + i));
+        __m256i b = _mm256_loadu_si256((const __m256i*)(src + i));
+        _mm256_storeu_si256((__m256i*)(dst + i), _mm256_or_si256(a, b));
+    }
+    return i;
+}
+
+__attribute__((target("avx2")))
+static size_t xorWordsAvx2(uint64_t* dst, const uint64_t* src, size_t count) {
+    size_t i = 0;
+    for (; i + 4 <= count; i += 4) {
+        __m256i a = _mm256_loadu_si256((const __m256i*)(dst + i));
+        __m256i b = _mm256_loadu_si256((const __m256i*)(src + i));
+        _mm256_storeu_si256((__m256i*)(dst + i), _mm256_xor_si256(a, b));
+    }
+    return i;
+}
+
+__attribute__((target("avx2")))
+static size_t notWordsAvx2(uint64_t* dst, size_t count) {
+    size_t i = 0;
+    __m256i ones = _mm256_set1_epi32(-1);
+    for (; i + 4 <= count; i += 4) {
+        __m256i a = _mm256_loadu_si256((const __m256i*)(dst + i));
+        _mm256_storeu_si256((__m256i*)(dst + i), _mm256_xor_si256(a, ones));
+    }
+    return i;
+}
+
+/**
+ * @brief Nibble-lookup popcount (Mula) with per-step horizontal byte sums
+ */
+__attribute__((target("avx2")))
+static size_t popcountWordsAvx2(const uint64_t* src, size_t count, size_t* processed) {
+    const __m256i lookup = _mm256_setr_epi8(
+        0, 1, 1, 2, 1, 2, 2, 3, 1, 2, 2, 3, 2, 3, 3, 4,
+        0, 1, 1, 2, 1, 2, 2, 3, 1, 2, 2, 3, 2, 3, 3, 4);
+    const __m256i low_mask = _mm256_set1_epi8(0x0f);
+    __m256i acc = _mm256_setzero_si256();
+
+    size_t i = 0;
+    for (; i + 4 <= count; i += 4) {
+        __m256i v = _mm256_loadu_si256((const __m256i*)(src + i));
+        __m256i lo = _mm256_and_si256(v, low_mask);
+        __m256i hi = _mm256_and_si256(_mm256_srli_epi16(v, 4), low_mask);
+        __m256i bytes = _mm256_add_epi8(_mm256_shuffle_epi8(lookup, lo),
+                                        _mm256_shuffle_epi8(lookup, hi));
+        acc = _mm256_add_epi64(acc, _mm256_sad_epu8(bytes, _mm256_setzero_si256()));
+    }
+
+    *processed = i;
+    return (size_t)_mm256_extract_epi64(acc, 0) + (size_t)_mm256_extract_epi64(acc, 1) +
+           (size_t)_mm256_extract_epi64(acc, 2) + (size_t)_mm256_extract_epi64(acc, 3);
+}
+
+/**
+ * @brief Index of first non-zero word in [start, count), or count
+ */
+__attribute__((target("avx2")))
+static size_t findNonZeroWordAvx2(const uint64_t* src, size_t start, size_t count) {
+    size_t i = start;
+    for (; i + 4 <= count; i += 4) {
+        __m256i v = _mm256_loadu_si256((const __m256i*)(src + i));
+        if (!_mm256_testz_si256(v, v)) break;
+    }
+    while (i < count && src[i] == 0) i++;
+    return i;
+}
+
+__attribute__((target("popcnt")))
+static size_t popcountWordsHw(const uint64_t* src, size_t count) {
+    size_t total = 0;
+    for (size_t i = 0; i < count; i++) {
+        total += (size_t)__builtin_popcountll(src[i]);
+    }
+    return total;
+}
+
+static size_t popcountWordsGeneric(const uint64_t* src, size_t count) {
+    size_t total = 0;
+    for (size_t i = 0; i < count; i++) {
+        total += (size_t)__builtin_popcountll(src[i]);
+    }
+    return total;
+}
+
+// ===== BOOLEAN ARRAY =====
+
+BooleanArray::BooleanArray() : words(nullptr), word_capacity(0), length(0) {}
+
+BooleanArray::BooleanArray(size_t initial_length, bool value)
+    : words(nullptr), word_capacity(0), length(0) {
+    reserveBits(initial_length);
+    length = initial_length;
+    if (value) fill(true);
+}
+
+BooleanArray::~BooleanArray() {
+    if (words) {
+        Luna::Memory::deallocate(words);
+    }
+}
+
+bool BooleanArray::get(size_t index) const {
+    if (index >= length) return false;
+    return (words[index >> 6] >> (index & 63)) & 1;
+}
+
+void BooleanArray::set(size_t index, bool value) {
+    if (index >= length) return;
+    uint64_t mask = 1ULL << (index & 63);
+    if (value) {
+        words[index >> 6] |= mask;
+    } else {
+        words[index >> 6] &= ~mask;
+    }
+}
+
+void BooleanArray::push(bool value) {
+    reserveBits(length + 1);
+    length++;
+    set(length - 1, value);
+}
+
+void BooleanArray::fill(bool value) {
+    Luna::Memory::set(words, value ? 0xFF : 0, getWordCount() * sizeof(uint64_t));
+    clearTail();
+}
+
+size_t BooleanArray::getLength() const {
+    return length;
+}
+
+bool BooleanArray::isEmpty() const {
+    return length == 0;
+}
+
+void BooleanArray::logicalAnd(const BooleanArray& other) {
+    size_t count = getWordCount();
+    size_t shared = other.getWordCount() < count ? other.getWordCount() : count;
+
+    size_t i = Luna::Cpu::hasAvx2() ? andWordsAvx2(words, other.words, shared) : 0;
+    for (; i < shared; i++) words[i] &= other.words[i];
+
+    // Flags past the other array's end AND with false
+    if (shared < count) {
+        Luna::Memory::set(words + shared, 0, (count - shared) * sizeof(uint64_t));
+    }
+}
+
+void BooleanArray::logicalOr(const BooleanArray& other) {
+    size_t count = getWordCount();
+    size_t shared = other.getWordCount() < count ? other.getWordCount() : count;
+
+    size_t i = Luna::Cpu::hasAvx2() ? orWordsAvx2(words, other.words, shared) : 0;
+    for (; i < shared; i++) words[i] |= other.words[i];
+    clearTail();
+}
+
+void BooleanArray::logicalXor(const BooleanArray& other) {
+    size_t count = getWordCount();
+    size_t shared = other.getWordCount() < count ? other.getWordCount() : count;
+
+    size_t i = Luna::Cpu::hasAvx2() ? xorWordsAvx2(words, other.words, shared) : 0;
+    for (; i < shared; i++) words[i] ^= other.words[i];
+    clearTail();
+}
+
+void BooleanArray::logicalNot() {
+    size_t count = getWordCount();
+
+    size_t i = Luna::Cpu::hasAvx2() ? notWordsAvx2(words, count) : 0;
+    for (; i < count; i++) words[i] = ~words[i];
+    clearTail();
+}
+
+size_t BooleanArray::popcount() const {
+    size_t count = getWordCount();
+    size_t total = 0;
+    size_t i = 0;
+
+    if (Luna::Cpu::hasAvx2()) {
+        total = popcountWordsAvx2(words, count, &i);
+    }
+    if (Luna::Cpu::hasPopcnt()) {
+        return total + popcountWordsHw(words + i, count - i);
+    }
+    return total + popcountWordsGeneric(words + i, count - i);
+}
+
+size_t BooleanArray::findFirstSet(size_t from) const {
+    if (from >= length) return npos;
+
+    size_t count = getWordCount();
+    size_t w = from >> 6;
+
+    // First word may start mid-way
+    uint64_t bits = words[w] & (~0ULL << (from & 63));
+    if (bits) return (w << 6) + (size_t)__builtin_ctzll(bits);
+
+    w++;
+    if (Luna::Cpu::hasAvx2()) {
+        w = findNonZeroWordAvx2(words, w, count);
+    } else {
+        while (w < count && words[w] == 0) w++;
+    }
+
+    if (w >= count) return npos;
+    return (w << 6) + (size_t)__builtin_ctzll(words[w]);
+}
+
+void BooleanArray::reserveBits(size_t bit_count) {
+    size_t needed = (bit_count + 63) >> 6;
+    if (needed <= word_capacity) return;
+
+    size_t new_capacity = word_capacity ? word_capacity * 2 : 4;
+    if (new_capacity < needed) new_capacity = needed;
+
+    uint64_t* new_words = (uint64_t*)Luna::Memory::allocate(new_capacity * sizeof(uint64_t));
+
+    // Unused words must read as zero so growth never exposes stale flags
+    Luna::Memory::copy(new_words, words, word_capacity * sizeof(uint64_t));
+    Luna::Memory::set(new_words + word_capacity, 0, (new_capacity - word_capacity) * sizeof(uint64_t));
+
+    Luna::Memory::deallocate(words);
+    words = new_words;
+    word_capacity = new_capacity;
+}
+
+void BooleanArray::clearTail() {
+    size_t tail = length & 63;
+    if (tail) {
+        words[length >> 6] &= (1ULL << tail) - 1;
+    }
+}
@@ -0,0 +1,150 @@
+#pragma once
+
+#include "lib/memory.hpp"
+
+typedef unsigned long uint64_t;
+
+/**
+ * @brief Bit-packed array of flags (64 flags per word)
+ *
+ * Bits past getLength() are always kept zero so that popcount and
+ * searches never have to mask the last word.
+ */
+class BooleanArray {
+private:
+    uint64_t* words;
+    size_t word_capacity;
+    size_t length;
+
+public:
+    static const size_t npos = (size_t)-1;
+
+    /**
+     * @brief Construct empty bit array
+     */
+    BooleanArray();
+
+    /**
+     * @brief Construct bit array of given length, every flag set to value
+     */
+    BooleanArray(size_t initial_length, bool value = false);
+
+    /**
+     * @brief Destroy bit array and free memory
+     */
+    ~BooleanArray();
+
+    BooleanArray(const BooleanArray&) = delete;
+    BooleanArray& operator=(const BooleanArray&) = delete;
+
+    /**
+     * @brief Get flag at index (false when out of range)
+     */
+    bool get(size_t index) const;
+
+    /**
+     * @brief Set flag at index
+     */
+    void set(size_t index, bool value);
+
+    /**
+     * @brief Append flag to end
+     */
+    void push(bool value);
+
+    /**
+     * @brief Set every flag to value
+     */
+    void fill(bool value);
+
+    /**
+     * @brief Get number of flags
+     */
+    size_t getLength() const;
+
+    /**
+     * @brief Check if array has no flags
+     */
+    bool isEmpty() const;
+
+    /**
+     * @brief In-place AND (flags past other's length become false)
+     */
+    void logicalAnd(const BooleanArray& other);
+
+    /**
+     * @brief In-place OR (flags past other's length are unchanged)
+     */
+    void logicalOr(const BooleanArray& other);
+
+    /**
+     * @brief In-place XOR (flags past other's length are unchanged)
+     */
+    void logicalXor(const BooleanArray& other);
+
+    /**
+     * @brief In-place NOT
+     */
+    void logicalNot();
+
+    /**
+     * @brief Count set flags
+     */
+    size_t popcount() const;
+
+    /**
+     * @brief Index of first set flag at or after from, or npos
+     */
+    size_t findFirstSet(size_t from = 0) const;
+
+    /**
+     * @brief Raw word storage (getWordCount() words)
+     */
+    const uint64_t* getWords() const { return words; }
+
+    /**
+     * @brief Number of words covering getLength() flags
+     */
+    size_t getWordCount() const { return (length + 63) >> 6; }
+
+    /**
+     * @brief Call fn(index) for every set flag in ascending order
+     */
+    template<typename Fn>
+    void forEachSet(Fn fn) const {
+        size_t count = getWordCount();
+        for (size_t w = 0; w < count; w++) {
+            uint64_t bits = words[w];
+            while (bits) {
+                fn((w << 6) + (size_t)__builtin_ctzll(bits));
+                bits &= bits - 1;
+            }
+        }
+    }
+
+    // ===== SET-BIT ITERATION =====
+    class iterator {
+    private:
+        const BooleanArray* owner_;
+        size_t index_;
+    public:
+        iterator(const BooleanArray* owner, size_t index) : owner_(owner), index_(index) {}
+        size_t operator*() const { return index_; }
+        iterator& operator++() { index_ = owner_->findFirstSet(index_ + 1); return *this; }
+        bool operator!=(const iterator& other) const { return index_ != other.index_; }
+    };
+
+    iterator begin() const { return iterator(this, findFirstSet(0)); }
+    iterator end() const { return iterator(this, npos); }
+
+private:
+    /**
+     * @brief Grow word storage to hold at least bit_count flags
+     */
+    void reserveBits(size_t bit_count);
+
+    /**
+     * @brief Clear bits in the last word that lie past length
+     */
+    void clearTail();
+};
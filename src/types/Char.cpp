@@ -1,5 +1,105 @@
 #include "Char.hpp"
 #include "lib/memory.hpp"
+#include "lib/cpu.hpp"
+#include <immintrin.h>
+
+// ===== CHARACTER CLASS TABLE =====
+
+/**
+ * @brief 256-entry class table, built at compile time
+ */
+struct ClassTable {
+    uint8_t entries[256];
+    
+    constexpr ClassTable() : entries() {
+        for (int c = 0; c < 256; c++) {
+            uint8_t bits = 0;
+            if (c >= '0' && c <= '9') bits |= Char::DIGIT | Char::HEX_DIGIT | Char::IDENTIFIER_PART;
+            if (c >= 'A' && c <= 'Z') bits |= Char::UPPER | Char::IDENTIFIER_START | Char::IDENTIFIER_PART;
+            if (c >= 'a' && c <= 'z') bits |= Char::LOWER | Char::IDENTIFIER_START | Char::IDENTIFIER_PART;
+            if ((c >= 'A' && c <= 'F') || (c >= 'a' && c <= 'f')) bits |= Char::HEX_DIGIT;
+            if (c == '_' || c == '$') bits |= Char::IDENTIFIER_START | Char::IDENTIFIER_PART;
+            // ' ', \t, \n, \v, \f, \r (the ASCII part of JS WhiteSpace/LineTerminator)
+            if (c == ' ' || (c >= 0x09 && c <= 0x0D)) bits |= Char::WHITESPACE;
+            entries[c] = bits;
+        }
+    }
+};
+
+static constexpr ClassTable g_class_table;
+
+static inline uint8_t classOf(char c) {
+    return g_class_table.entries[(unsigned char)c];
+}
+
+// ===== SSE2 KERNELS (always available on x86-64) =====
+
+static inline __m128i whitespaceMask16(__m128i v) {
+    __m128i space = _mm_cmpeq_epi8(v, _mm_set1_epi8(' '));
+    __m128i control = _mm_and_si128(_mm_cmpgt_epi8(v, _mm_set1_epi8(0x08)),
+                                    _mm_cmplt_epi8(v, _mm_set1_epi8(0x0E)));
+    return _mm_or_si128(space, control);
+}
+
+static inline __m128i digitMask16(__m128i v) {
+    // Bytes >= 0x80 compare as negative, so they never pass the lower bound
+    return _mm_and_si128(_mm_cmpgt_epi8(v, _mm_set1_epi8('0' - 1)),
+                         _mm_cmplt_epi8(v, _mm_set1_epi8('9' + 1)));
+}
+
+// ===== AVX2 KERNELS =====
+
+__attribute__((target("avx2")))
+static inline __m256i whitespaceMask32(__m256i v) {
+    __m256i space = _mm256_cmpeq_epi8(v, _mm256_set1_epi8(' '));
+    __m256i control = _mm256_and_si256(_mm256_cmpgt_epi8(v, _mm256_set1_epi8(0x08)),
+                                       _mm256_cmpgt_epi8(_mm256_set1_epi8(0x0E), v));
+    return _mm256_or_si256(space, control);
+}
+
+__attribute__((target("avx2")))
+static inline __m256i digitMask32(__m256i v) {
+    return _mm256_and_si256(_mm256_cmpgt_epi8(v, _mm256_set1_epi8('0' - 1)),
+                            _mm256_cmpgt_epi8(_mm256_set1_epi8('9' + 1), v));
+}
+
+/**
+ * @brief Advance i past 32-byte blocks that are entirely whitespace
+ */
+__attribute__((target("avx2")))
+static size_t skipWhitespaceAvx2(const char* data, size_t length) {
+    size_t i = 0;
+    for (; i + 32 <= length; i += 32) {
+        __m256i v = _mm256_loadu_si256((const __m256i*)(data + i));
+        unsigned int mask = (unsigned int)_mm256_movemask_epi8(whitespaceMask32(v));
+        if (mask != 0xFFFFFFFFu) return i + (size_t)__builtin_ctz(~mask);
+    }
+    return i;
+}
+
+__attribute__((target("avx2")))
+static size_t skipWhitespaceReverseAvx2(const char* data, size_t length) {
+    size_t end = length;
+    for (; end >= 32; end -= 32) {
+        __m256i v = _mm256_loadu_si256((const __m256i*)(data + end - 32));
+        unsigned int mask = (unsigned int)_mm256_movemask_epi8(whitespaceMask32(v));
+        if (mask != 0xFFFFFFFFu) return end - (size_t)__builtin_clz(~mask);
+    }
+    return end;
+}
+
+__attribute__((target("avx2")))
+static size_t skipDigitsAvx2(const char* data, size_t length) {
+    size_t i = 0;
+    for (; i + 32 <= length; i += 32) {
+        __m256i v = _mm256_loadu_si256((const __m256i*)(data + i));
+        unsigned int mask = (unsigned int)_mm256_movemask_epi8(digitMask32(v));
+        if (mask != 0xFFFFFFFFu) return i + (size_t)__builtin_ctz(~mask);
+    }
+    return i;
+}
+
+// ===== CHAR =====
 
 Char::Char(char c) : value(c) {}
 
@@ -9,24 +109,32 @@ char Char::getValue() const {
     return value;
 }
 
+uint8_t Char::getClass() const {
+    return classOf(value);
+}
+
+bool Char::is(uint8_t class_mask) const {
+    return (classOf(value) & class_mask) != 0;
+}
+
 bool Char::isDigit() const {
-    return value >= '0' && value <= '9';
+    return (classOf(value) & DIGIT) != 0;
 }
 
 bool Char::isLetter() const {
-    return (value >= 'A' && value <= 'Z') || (value >= 'a' && value <= 'z');
+    return (classOf(value) & LETTER) != 0;
 }
 
 bool Char::isWhitespace() const {
-    return value == ' ' || value == '\t' || value == '\n' || value == '\r';
+    return (classOf(value) & WHITESPACE) != 0;
 }
 
 bool Char::isUpperCase() const {
-    return value >= 'A' && value <= 'Z';
+    return (classOf(value) & UPPER) != 0;
 }
 
 bool Char::isLowerCase() const {
-    return value >= 'a' && value <= 'z';
+    return (classOf(value) & LOWER) != 0;
 }
 
 Char Char::toUpperCase() const {
@@ -82,4 +190,88 @@ Char Char::space() {
 
 Char Char::null() {
     return Char('\0');
-}
\ No newline at end of file
+}
+
+// Batch classification
+uint8_t Char::classify(char c) {
+    return classOf(c);
+}
+
+size_t Char::skipWhitespace(const char* data, size_t length) {
+    if (!data) return 0;
+    
+    size_t i = 0;
+    if (Luna::Cpu::hasAvx2()) {
+        i = skipWhitespaceAvx2(data, length);
+        if (i + 32 <= length) return i; // Stopped inside a block
+    }
+    
+    for (; i + 16 <= length; i += 16) {
+        __m128i v = _mm_loadu_si128((const __m128i*)(data + i));
+        unsigned int mask = (unsigned int)_mm_movemask_epi8(whitespaceMask16(v));
+        if (mask != 0xFFFF) return i + (size_t)__builtin_ctz(~mask);
+    }
+    
+    while (i < length && (classOf(data[i]) & WHITESPACE)) i++;
+    return i;
+}
+
+size_t Char::skipWhitespaceReverse(const char* data, size_t length) {
+    if (!data) return 0;
+    
+    size_t end = length;
+    if (Luna::Cpu::hasAvx2()) {
+        end = skipWhitespaceReverseAvx2(data, length);
+        if (end >= 32) return end; // Stopped inside a block
+    }
+    
+    for (; end >= 16; end -= 16) {
+        __m128i v = _mm_loadu_si128((const __m128i*)(data + end - 16));
+        unsigned int mask = (unsigned int)_mm_movemask_epi8(whitespaceMask16(v));
+        if (mask != 0xFFFF) return end - 16 + (size_t)(32 - __builtin_clz(~mask & 0xFFFF));
+    }
+    
+    while (end > 0 && (classOf(data[end - 1]) & WHITESPACE)) end--;
+    return end;
+}
+
+size_t Char::skipDigits(const char* data, size_t length) {
+    if (!data) return 0;
+    
+    size_t i = 0;
+    if (Luna::Cpu::hasAvx2()) {
+        i = skipDigitsAvx2(data, length);
+        if (i + 32 <= length) return i;
+    }
+    
+    for (; i + 16 <= length; i += 16) {
+        __m128i v = _mm_loadu_si128((const __m128i*)(data + i));
+        unsigned int mask = (unsigned int)_mm_movemask_epi8(digitMask16(v));
+        if (mask != 0xFFFF) return i + (size_t)__builtin_ctz(~mask);
+    }
+    
+    while (i < length && (classOf(data[i]) & DIGIT)) i++;
+    return i;
+}
+
+bool Char::allDigits(const char* data, size_t length) {
+    return skipDigits(data, length) == length;
+}
+
+size_t Char::findFirstIn(const char* data, size_t length, uint8_t class_mask) {
+    if (!data) return 0;
+    
+    for (size_t i = 0; i < length; i++) {
+        if (classOf(data[i]) & class_mask) return i;
+    }
+    return length;
+}
+
+size_t Char::findFirstNotIn(const char* data, size_t length, uint8_t class_mask) {
+    if (!data) return 0;
+    
+    for (size_t i = 0; i < length; i++) {
+        if (!(classOf(data[i]) & class_mask)) return i;
+    }
+    return length;
+}
@@ -2,11 +2,27 @@
 
 #include "lib/memory.hpp"
 
+typedef unsigned char uint8_t;
+
 class Char {
 private:
     char value;
 
 public:
+    /**
+     * @brief Character class bits stored in the 256-entry class table
+     */
+    enum Class : uint8_t {
+        DIGIT = 1 << 0,
+        UPPER = 1 << 1,
+        LOWER = 1 << 2,
+        WHITESPACE = 1 << 3,
+        HEX_DIGIT = 1 << 4,
+        IDENTIFIER_START = 1 << 5,  // letters, '_' and '$'
+        IDENTIFIER_PART = 1 << 6,   // identifier start plus digits
+        LETTER = UPPER | LOWER
+    };
+
     /**
      * @brief Construct char from ASCII value
      */
@@ -22,6 +38,16 @@ public:
      */
     char getValue() const;
     
+    /**
+     * @brief Get class bits of this character
+     */
+    uint8_t getClass() const;
+    
+    /**
+     * @brief Check if character belongs to any class in mask
+     */
+    bool is(uint8_t class_mask) const;
+    
     /**
      * @brief Check if character is digit
      */
@@ -101,4 +127,41 @@ public:
      * @brief Create null character
      */
     static Char null();
+    
+    // ===== BATCH CLASSIFICATION =====
+    
+    /**
+     * @brief Get class bits of a raw byte
+     */
+    static uint8_t classify(char c);
+    
+    /**
+     * @brief Index of first non-whitespace byte, or length if none
+     */
+    static size_t skipWhitespace(const char* data, size_t length);
+    
+    /**
+     * @brief Length of data with trailing whitespace removed
+     */
+    static size_t skipWhitespaceReverse(const char* data, size_t length);
+    
+    /**
+     * @brief Index of first non-digit byte, or length if none
+     */
+    static size_t skipDigits(const char* data, size_t length);
+    
+    /**
+     * @brief Check if every byte is an ASCII digit (true for empty input)
+     */
+    static bool allDigits(const char* data, size_t length);
+    
+    /**
+     * @brief Index of first byte in any class of mask, or length if none
+     */
+    static size_t findFirstIn(const char* data, size_t length, uint8_t class_mask);
+    
+    /**
+     * @brief Index of first byte in none of the classes of mask, or length if none
+     */
+    static size_t findFirstNotIn(const char* data, size_t length, uint8_t class_mask);
 };
\ No newline at end of file
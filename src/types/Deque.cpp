@@ -0,0 +1,96 @@
+#include "Deque.hpp"
+#include "lib/memory.hpp"
+
+static size_t roundUpToPowerOfTwo(size_t n) {
+    size_t capacity = 8;
+    while (capacity < n) capacity <<= 1;
+    return capacity;
+}
+
+Deque::Deque() : data(nullptr), capacity(0), head(0), length(0) {}
+
+Deque::Deque(size_t initial_capacity) : data(nullptr), capacity(0), head(0), length(0) {
+    reserve(initial_capacity);
+}
+
+Deque::~Deque() {
+    if (data) {
+        Luna::Memory::deallocate(data);
+    }
+}
+
+void Deque::set(size_t index, void* value) {
+    if (index >= length) return;
+    data[(head + index) & (capacity - 1)] = value;
+}
+
+void Deque::push(void* value) {
+    if (length == capacity) reallocate(capacity ? capacity * 2 : 8);
+    data[(head + length) & (capacity - 1)] = value;
+    length++;
+}
+
+void* Deque::pop() {
+    if (length == 0) return nullptr;
+    length--;
+    return data[(head + length) & (capacity - 1)];
+}
+
+void Deque::unshift(void* value) {
+    if (length == capacity) reallocate(capacity ? capacity * 2 : 8);
+    head = (head - 1) & (capacity - 1);
+    data[head] = value;
+    length++;
+}
+
+void* Deque::shift() {
+    if (length == 0) return nullptr;
+    void* value = data[head];
+    head = (head + 1) & (capacity - 1);
+    length--;
+    return value;
+}
+
+void Deque::clear() {
+    head = 0;
+    length = 0;
+}
+
+void Deque::reserve(size_t n) {
+    if (n > capacity) reallocate(roundUpToPowerOfTwo(n));
+}
+
+Array* Deque::toArray() const {
+    Array* result = new Array(length ? length : 1);
+    forEachSegment([&](void* const* items, size_t count) {
+        result->pushAll((const void* const*)items, count);
+    });
+    return result;
+}
+
+void* const* Deque::segment(size_t k, size_t* count) const {
+    size_t first = capacity - head < length ? capacity - head : length;
+    if (k == 0) {
+        *count = first;
+        return data + head;
+    }
+    *count = length - first;
+    return data;
+}
+
+void Deque::reallocate(size_t new_capacity) {
+    void** new_data = (void**)Luna::Memory::allocate(new_capacity * sizeof(void*));
+
+    // Unwrap: both segments land contiguously at the start
+    size_t first = 0;
+    if (length) {
+        first = capacity - head < length ? capacity - head : length;
+        Luna::Memory::copy(new_data, data + head, first * sizeof(void*));
+        Luna::Memory::copy(new_data + first, data, (length - first) * sizeof(void*));
+    }
+
+    Luna::Memory::deallocate(data);
+    data = new_data;
+    capacity = new_capacity;
+    head = 0;
+}
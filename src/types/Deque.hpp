@@ -0,0 +1,160 @@
+#pragma once
+
+#include "lib/memory.hpp"
+#include "types/Array.hpp"
+
+/**
+ * @brief Double-ended queue of pointers on a power-of-two ring buffer
+ *
+ * push/pop/shift/unshift are amortized O(1). Elements occupy at most two
+ * contiguous segments of the buffer (before and after the wrap point).
+ */
+class Deque {
+private:
+    void** data;
+    size_t capacity; // 0 or a power of two
+    size_t head;     // Buffer index of element 0
+    size_t length;
+
+public:
+    /**
+     * @brief Construct empty deque (allocates on first insert)
+     */
+    Deque();
+
+    /**
+     * @brief Construct deque with room for at least initial_capacity elements
+     */
+    Deque(size_t initial_capacity);
+
+    /**
+     * @brief Destroy deque and free memory
+     */
+    ~Deque();
+
+    Deque(const Deque&) = delete;
+    Deque& operator=(const Deque&) = delete;
+
+    /**
+     * @brief Get element at index from the front (nullptr when out of range)
+     */
+    void* get(size_t index) const {
+        if (index >= length) return nullptr;
+        return data[(head + index) & (capacity - 1)];
+    }
+
+    /**
+     * @brief Set element at index from the front
+     */
+    void set(size_t index, void* value);
+
+    /**
+     * @brief Append element to back
+     */
+    void push(void* value);
+
+    /**
+     * @brief Remove and return back element (nullptr when empty)
+     */
+    void* pop();
+
+    /**
+     * @brief Prepend element to front
+     */
+    void unshift(void* value);
+
+    /**
+     * @brief Remove and return front element (nullptr when empty)
+     */
+    void* shift();
+
+    /**
+     * @brief Front element without removing it (nullptr when empty)
+     */
+    void* front() const { return get(0); }
+
+    /**
+     * @brief Back element without removing it (nullptr when empty)
+     */
+    void* back() const { return length ? get(length - 1) : nullptr; }
+
+    /**
+     * @brief Get number of elements
+     */
+    size_t getLength() const { return length; }
+
+    /**
+     * @brief Get buffer capacity
+     */
+    size_t getCapacity() const { return capacity; }
+
+    /**
+     * @brief Check if deque is empty
+     */
+    bool isEmpty() const { return length == 0; }
+
+    /**
+     * @brief Remove all elements (capacity is kept)
+     */
+    void clear();
+
+    /**
+     * @brief Ensure capacity for at least n elements
+     */
+    void reserve(size_t n);
+
+    /**
+     * @brief Copy elements front to back into a new Array (caller manages memory)
+     */
+    Array* toArray() const;
+
+    // ===== SEGMENTS =====
+
+    /**
+     * @brief Number of contiguous runs holding the elements (0, 1 or 2)
+     */
+    size_t segmentCount() const {
+        if (length == 0) return 0;
+        return head + length > capacity ? 2 : 1;
+    }
+
+    /**
+     * @brief Contiguous run k of the elements, in front-to-back order
+     * @param count - Receives the number of elements in the run
+     */
+    void* const* segment(size_t k, size_t* count) const;
+
+    /**
+     * @brief Call fn(items, count) for each contiguous run, front to back
+     */
+    template<typename Fn>
+    void forEachSegment(Fn fn) const {
+        size_t segments = segmentCount();
+        for (size_t k = 0; k < segments; k++) {
+            size_t count;
+            void* const* items = segment(k, &count);
+            fn(items, count);
+        }
+    }
+
+    // ===== ITERATION =====
+    class iterator {
+    private:
+        const Deque* owner_;
+        size_t index_;
+    public:
+        iterator(const Deque* owner, size_t index) : owner_(owner), index_(index) {}
+        void* operator*() const { return owner_->get(index_); }
+        iterator& operator++() { index_++; return *this; }
+        bool operator!=(const iterator& other) const { return index_ != other.index_; }
+    };
+
+    iterator begin() const { return iterator(this, 0); }
+    iterator end() const { return iterator(this, length); }
+
+private:
+    /**
+     * @brief Move elements into a buffer of new_capacity (a power of two), unwrapped
+     */
+    void reallocate(size_t new_capacity);
+};
@@ -0,0 +1,188 @@
+#include "Map.hpp"
+#include <emmintrin.h>
+
+namespace Luna {
+
+// ===== HASHING =====
+namespace Hash {
+
+static const uint64_t MULTIPLIER_A = 0x9E3779B97F4A7C15ull;
+static const uint64_t MULTIPLIER_B = 0xC2B2AE3D27D4EB4Full;
+
+static inline uint64_t rotateLeft(uint64_t value, int bits) {
+    return (value << bits) | (value >> (64 - bits));
+}
+
+uint64_t mix(uint64_t value) {
+    // MurmurHash3 finalizer
+    value ^= value >> 33;
+    value *= 0xFF51AFD7ED558CCDull;
+    value ^= value >> 33;
+    value *= 0xC4CEB9FE1A85EC53ull;
+    value ^= value >> 33;
+    return value;
+}
+
+uint64_t bytes(const void* data, size_t length) {
+    const unsigned char* ptr = (const unsigned char*)data;
+    uint64_t hash = (uint64_t)length * MULTIPLIER_A;
+
+    // One multiply per 8-byte word; unaligned loads compile to plain moves
+    while (length >= 8) {
+        uint64_t word;
+        __builtin_memcpy(&word, ptr, 8);
+        hash = rotateLeft(hash ^ (word * MULTIPLIER_B), 31) * MULTIPLIER_A;
+        ptr += 8;
+        length -= 8;
+    }
+    if (length) {
+        uint64_t word = 0;
+        __builtin_memcpy(&word, ptr, length);
+        hash = rotateLeft(hash ^ (word * MULTIPLIER_B), 31) * MULTIPLIER_A;
+    }
+    return mix(hash);
+}
+
+uint64_t number(const Number& value) {
+    union {
+        double as_double;
+        uint64_t as_bits;
+    } pun;
+    pun.as_double = value.toDouble();
+
+    // Every NaN and both zeros must land in the same bucket
+    if (pun.as_double != pun.as_double) return mix(0x7FF8000000000000ull);
+    if (pun.as_double == 0.0) return mix(0);
+    return mix(pun.as_bits);
+}
+
+} // namespace Hash
+
+// ===== SWISS INDEX =====
+
+namespace {
+
+const size_t GROUP_WIDTH = 16;
+const uint8_t EMPTY = 0x80;
+const uint8_t DELETED = 0xFE;
+
+inline uint8_t tagOf(uint64_t hash) { return (uint8_t)(hash & 0x7F); }
+
+inline __m128i loadGroup(const uint8_t* control, size_t group) {
+    return _mm_loadu_si128((const __m128i*)(control + group * GROUP_WIDTH));
+}
+
+inline uint32_t matchByte(__m128i group, uint8_t value) {
+    return (uint32_t)_mm_movemask_epi8(_mm_cmpeq_epi8(group, _mm_set1_epi8((char)value)));
+}
+
+// EMPTY and DELETED are the only control bytes with the high bit set
+inline uint32_t matchFree(__m128i group) {
+    return (uint32_t)_mm_movemask_epi8(group);
+}
+
+} // namespace
+
+HashIndex::HashIndex() : control(nullptr), slots(nullptr), capacity(0), occupied(0) {}
+
+HashIndex::~HashIndex() {
+    Memory::deallocate(control);
+    Memory::deallocate(slots);
+}
+
+void HashIndex::reset(size_t new_capacity) {
+    if (new_capacity != capacity) {
+        Memory::deallocate(control);
+        Memory::deallocate(slots);
+        control = nullptr;
+        slots = nullptr;
+        capacity = 0;
+
+        if (new_capacity) {
+            size_t rounded = GROUP_WIDTH;
+            while (rounded < new_capacity) rounded <<= 1;
+            control = (uint8_t*)Memory::allocate(rounded);
+            slots = (uint32_t*)Memory::allocate(rounded * sizeof(uint32_t));
+            capacity = rounded;
+        }
+    }
+    if (capacity) Memory::set(control, EMPTY, capacity);
+    occupied = 0;
+}
+
+void HashIndex::start(uint64_t hash, Probe* probe) const {
+    size_t group_mask = capacity / GROUP_WIDTH - 1;
+    probe->group = (size_t)(hash >> 7) & group_mask;
+    probe->step = 0;
+    probe->tag = tagOf(hash);
+
+    __m128i group = loadGroup(control, probe->group);
+    probe->matches = matchByte(group, probe->tag);
+    probe->last = matchByte(group, EMPTY) != 0;
+}
+
+size_t HashIndex::next(Probe* probe) const {
+    size_t groups = capacity / GROUP_WIDTH;
+    for (;;) {
+        if (probe->matches) {
+            size_t bit = (size_t)__builtin_ctz(probe->matches);
+            probe->matches &= probe->matches - 1;
+            return slots[probe->group * GROUP_WIDTH + bit];
+        }
+        // A group with an empty slot ends every chain that reaches it
+        if (probe->last || ++probe->step >= groups) return npos;
+
+        // Triangular steps visit every group of a power-of-two table
+        probe->group = (probe->group + probe->step) & (groups - 1);
+        __m128i group = loadGroup(control, probe->group);
+        probe->matches = matchByte(group, probe->tag);
+        probe->last = matchByte(group, EMPTY) != 0;
+    }
+}
+
+void HashIndex::insert(uint64_t hash, size_t entry) {
+    size_t group_mask = capacity / GROUP_WIDTH - 1;
+    size_t group_index = (size_t)(hash >> 7) & group_mask;
+
+    for (size_t step = 1;; step++) {
+        uint32_t free = matchFree(loadGroup(control, group_index));
+        if (free) {
+            size_t at = group_index * GROUP_WIDTH + (size_t)__builtin_ctz(free);
+            if (control[at] == EMPTY) occupied++;
+            control[at] = tagOf(hash);
+            slots[at] = (uint32_t)entry;
+            return;
+        }
+        group_index = (group_index + step) & group_mask;
+    }
+}
+
+void HashIndex::erase(uint64_t hash, size_t entry) {
+    size_t group_mask = capacity / GROUP_WIDTH - 1;
+    size_t group_index = (size_t)(hash >> 7) & group_mask;
+    uint8_t tag = tagOf(hash);
+
+    for (size_t step = 1; step <= group_mask + 1; step++) {
+        __m128i group = loadGroup(control, group_index);
+        bool has_empty = matchByte(group, EMPTY) != 0;
+
+        for (uint32_t matches = matchByte(group, tag); matches; matches &= matches - 1) {
+            size_t at = group_index * GROUP_WIDTH + (size_t)__builtin_ctz(matches);
+            if (slots[at] != (uint32_t)entry) continue;
+
+            // Probes stop at a group that already has an empty slot, so
+            // freeing this one cannot cut a chain that runs past it
+            if (has_empty) {
+                control[at] = EMPTY;
+                occupied--;
+            } else {
+                control[at] = DELETED;
+            }
+            return;
+        }
+        if (has_empty) return;
+        group_index = (group_index + step) & group_mask;
+    }
+}
+
+} // namespace Luna
@@ -0,0 +1,512 @@
+#pragma once
+
+#include "lib/memory.hpp"
+#include "types/Number.hpp"
+#include "types/Strings.hpp"
+#include <new>
+
+typedef unsigned int uint32_t;
+typedef unsigned long uint64_t;
+
+namespace Luna {
+
+// ===== HASHING =====
+namespace Hash {
+    /**
+     * @brief Hash a byte range
+     */
+    uint64_t bytes(const void* data, size_t length);
+
+    /**
+     * @brief Scramble a 64-bit value so every input bit affects every output bit
+     */
+    uint64_t mix(uint64_t value);
+
+    /**
+     * @brief Hash a Number under SameValueZero (-0 == +0, NaN == NaN, 1 == 1.0)
+     */
+    uint64_t number(const Number& value);
+}
+
+/**
+ * @brief Key hashing and equality used by Map and Set
+ */
+template<typename K>
+struct HashTraits;
+
+template<>
+struct HashTraits<std::string> {
+    static uint64_t hash(const std::string& key) { return Hash::bytes(key.c_str(), key.length()); }
+    static bool equals(const std::string& a, const std::string& b) {
+        return a.length() == b.length() && Memory::compare(a.c_str(), b.c_str(), a.length()) == 0;
+    }
+};
+
+template<>
+struct HashTraits<Number> {
+    static uint64_t hash(const Number& key) { return Hash::number(key); }
+    static bool equals(const Number& a, const Number& b) {
+        double x = a.toDouble();
+        double y = b.toDouble();
+        return x == y || (x != x && y != y);
+    }
+};
+
+template<>
+struct HashTraits<Interned> {
+    static uint64_t hash(const Interned& key) { return key.hash(); }
+    static bool equals(const Interned& a, const Interned& b) { return a == b; }
+};
+
+template<typename T>
+struct HashTraits<T*> {
+    static uint64_t hash(T* key) { return Hash::mix((uint64_t)(uintptr_t)key); }
+    static bool equals(T* a, T* b) { return a == b; }
+};
+
+/**
+ * @brief Swiss-table index: 16-wide groups of control bytes probed with SSE2
+ *
+ * Each slot holds the position of an entry in the owning table's
+ * insertion-ordered storage; the control byte holds 7 bits of its hash.
+ * The owner keeps the index at most half full of live slots and rebuilds
+ * it when tombstones crowd it.
+ */
+class HashIndex {
+private:
+    uint8_t* control;
+    uint32_t* slots;
+    size_t capacity; // 0 or a power of two >= 16
+    size_t occupied; // Full slots plus tombstones
+
+public:
+    static const size_t npos = (size_t)-1;
+
+    /**
+     * @brief Position in the probe sequence of one lookup
+     */
+    struct Probe {
+        size_t group;
+        size_t step;
+        uint32_t matches; // Unvisited candidate bits in the current group
+        uint8_t tag;
+        bool last;        // Current group has an empty slot: stop after it
+    };
+
+    HashIndex();
+    ~HashIndex();
+
+    HashIndex(const HashIndex&) = delete;
+    HashIndex& operator=(const HashIndex&) = delete;
+
+    /**
+     * @brief Drop all slots and resize to new_capacity (0 frees the index)
+     */
+    void reset(size_t new_capacity);
+
+    /**
+     * @brief Get number of slots
+     */
+    size_t getCapacity() const { return capacity; }
+
+    /**
+     * @brief Check if one more insert would push probe chains past 7/8 load
+     */
+    bool isCrowded() const { return (occupied + 1) * 8 > capacity * 7; }
+
+    /**
+     * @brief Start probing for hash
+     */
+    void start(uint64_t hash, Probe* probe) const;
+
+    /**
+     * @brief Next entry whose tag matches, or npos when the probe is exhausted
+     */
+    size_t next(Probe* probe) const;
+
+    /**
+     * @brief Record entry under hash (the key must not be present)
+     */
+    void insert(uint64_t hash, size_t entry);
+
+    /**
+     * @brief Remove the slot recording entry under hash
+     */
+    void erase(uint64_t hash, size_t entry);
+};
+
+/**
+ * @brief Insertion-ordered hash table shared by Map and Set
+ *
+ * Entries live in a dense array in insertion order; removed entries are
+ * left as holes and squeezed out when the array next needs to grow.
+ */
+template<typename K, typename Entry>
+class HashTable {
+private:
+    struct Record {
+        uint64_t hash;
+        bool live;
+        alignas(Entry) unsigned char storage[sizeof(Entry)];
+
+        Entry* entry() { return (Entry*)storage; }
+        const Entry* entry() const { return (const Entry*)storage; }
+    };
+
+    Record* records;
+    size_t record_capacity;
+    size_t used;  // Records handed out, live or not
+    size_t count; // Live records
+    HashIndex index;
+
+public:
+    HashTable() : records(nullptr), record_capacity(0), used(0), count(0) {}
+
+    ~HashTable() {
+        clear();
+        Memory::deallocate(records);
+    }
+
+    HashTable(const HashTable&) = delete;
+    HashTable& operator=(const HashTable&) = delete;
+
+    size_t getSize() const { return count; }
+    size_t getCapacity() const { return record_capacity; }
+
+    Entry* find(const K& key, uint64_t hash) const {
+        size_t at = locate(key, hash);
+        return at == HashIndex::npos ? nullptr : records[at].entry();
+    }
+
+    Entry* find(const K& key) const { return find(key, HashTraits<K>::hash(key)); }
+
+    /**
+     * @brief Append a new entry built from args (the key must not be present)
+     */
+    template<typename... Args>
+    Entry* append(uint64_t hash, const Args&... args) {
+        if (used == record_capacity) {
+            // Sized by live entries, so churn compacts in place
+            makeRoom(count + 1);
+        } else if (index.isCrowded()) {
+            rebuildIndex();
+        }
+        Record& record = records[used];
+        new (record.storage) Entry{ args... };
+        record.hash = hash;
+        record.live = true;
+        index.insert(hash, used);
+        used++;
+        count++;
+        return record.entry();
+    }
+
+    bool remove(const K& key) {
+        uint64_t hash = HashTraits<K>::hash(key);
+        size_t at = locate(key, hash);
+        if (at == HashIndex::npos) return false;
+
+        index.erase(hash, at);
+        records[at].entry()->~Entry();
+        records[at].live = false;
+        count--;
+
+        // Trailing holes can be reused straight away
+        while (used > 0 && !records[used - 1].live) used--;
+        return true;
+    }
+
+    void clear() {
+        for (size_t i = 0; i < used; i++) {
+            if (records[i].live) records[i].entry()->~Entry();
+        }
+        used = 0;
+        count = 0;
+        if (record_capacity) index.reset(record_capacity * 2);
+    }
+
+    void reserve(size_t n) {
+        if (n > record_capacity) makeRoom(n);
+    }
+
+    /**
+     * @brief Call fn(entry) for each entry in insertion order (fn must not add entries)
+     */
+    template<typename Fn>
+    void forEach(Fn fn) const {
+        for (size_t i = 0; i < used; i++) {
+            if (records[i].live) fn(*records[i].entry());
+        }
+    }
+
+    // ===== ITERATION =====
+    class iterator {
+    private:
+        const HashTable* owner_;
+        size_t index_;
+
+        void skipHoles() {
+            while (index_ < owner_->used && !owner_->records[index_].live) index_++;
+        }
+    public:
+        iterator(const HashTable* owner, size_t index) : owner_(owner), index_(index) { skipHoles(); }
+        const Entry& operator*() const { return *owner_->records[index_].entry(); }
+        iterator& operator++() { index_++; skipHoles(); return *this; }
+        bool operator!=(const iterator& other) const { return index_ != other.index_; }
+    };
+
+    iterator begin() const { return iterator(this, 0); }
+    iterator end() const { return iterator(this, used); }
+
+private:
+    /**
+     * @brief Record position holding key, or npos
+     */
+    size_t locate(const K& key, uint64_t hash) const {
+        if (count == 0) return HashIndex::npos;
+        HashIndex::Probe probe;
+        index.start(hash, &probe);
+        for (size_t at = index.next(&probe); at != HashIndex::npos; at = index.next(&probe)) {
+            const Record& record = records[at];
+            if (record.hash == hash && HashTraits<K>::equals(record.entry()->key, key)) return at;
+        }
+        return HashIndex::npos;
+    }
+
+    /**
+     * @brief Squeeze out holes, growing storage if that alone leaves no room for n
+     */
+    void makeRoom(size_t n) {
+        size_t new_capacity = record_capacity ? record_capacity : 8;
+        while (new_capacity < n || new_capacity < count * 2) new_capacity *= 2;
+
+        Record* target = records;
+        if (new_capacity != record_capacity) {
+            target = (Record*)Memory::allocate(new_capacity * sizeof(Record));
+        }
+
+        size_t kept = 0;
+        for (size_t i = 0; i < used; i++) {
+            Record& record = records[i];
+            if (!record.live) continue;
+            Record& moved = target[kept++];
+            if (&moved != &record) {
+                new (moved.storage) Entry(static_cast<Entry&&>(*record.entry()));
+                record.entry()->~Entry();
+                moved.hash = record.hash;
+                moved.live = true;
+            }
+        }
+
+        if (target != records) {
+            Memory::deallocate(records);
+            records = target;
+            record_capacity = new_capacity;
+        }
+        used = kept;
+
+        rebuildIndex();
+    }
+
+    /**
+     * @brief Re-index live records from scratch, dropping tombstones
+     */
+    void rebuildIndex() {
+        // At most record_capacity live records: twice that keeps load at half
+        index.reset(record_capacity * 2);
+        for (size_t i = 0; i < used; i++) {
+            if (records[i].live) index.insert(records[i].hash, i);
+        }
+    }
+};
+
+/**
+ * @brief Key/value map with JS Map semantics: SameValueZero keys, insertion order
+ */
+template<typename K, typename V>
+class Map {
+public:
+    struct Entry {
+        K key;
+        V value;
+    };
+
+private:
+    HashTable<K, Entry> table;
+
+public:
+    /**
+     * @brief Construct empty map
+     */
+    Map() {}
+
+    Map(const Map&) = delete;
+    Map& operator=(const Map&) = delete;
+
+    /**
+     * @brief Insert or overwrite the value for key (existing keys keep their position)
+     */
+    void set(const K& key, const V& value) {
+        uint64_t hash = HashTraits<K>::hash(key);
+        Entry* entry = table.find(key, hash);
+        if (entry) {
+            entry->value = value;
+        } else {
+            table.append(hash, key, value);
+        }
+    }
+
+    /**
+     * @brief Pointer to the value for key, or nullptr if absent
+     */
+    V* get(const K& key) {
+        Entry* entry = table.find(key);
+        return entry ? &entry->value : nullptr;
+    }
+    const V* get(const K& key) const {
+        const Entry* entry = table.find(key);
+        return entry ? &entry->value : nullptr;
+    }
+
+    /**
+     * @brief Check if key is present
+     */
+    bool has(const K& key) const { return table.find(key) != nullptr; }
+
+    /**
+     * @brief Remove key (JS delete)
+     * @returns true if the key was present
+     */
+    bool remove(const K& key) { return table.remove(key); }
+
+    /**
+     * @brief Get number of entries
+     */
+    size_t getSize() const { return table.getSize(); }
+
+    /**
+     * @brief Get number of entries held before the storage has to grow
+     */
+    size_t getCapacity() const { return table.getCapacity(); }
+
+    /**
+     * @brief Check if map is empty
+     */
+    bool isEmpty() const { return table.getSize() == 0; }
+
+    /**
+     * @brief Remove all entries
+     */
+    void clear() { table.clear(); }
+
+    /**
+     * @brief Ensure room for n entries without rehashing
+     */
+    void reserve(size_t n) { table.reserve(n); }
+
+    /**
+     * @brief Call fn(key, value) for each entry in insertion order
+     */
+    template<typename Fn>
+    void forEach(Fn fn) const {
+        table.forEach([&](const Entry& entry) { fn(entry.key, entry.value); });
+    }
+
+    typedef typename HashTable<K, Entry>::iterator iterator;
+    iterator begin() const { return table.begin(); }
+    iterator end() const { return table.end(); }
+};
+
+/**
+ * @brief Value set with JS Set semantics: SameValueZero, insertion order
+ */
+template<typename K>
+class Set {
+public:
+    struct Entry {
+        K key;
+    };
+
+private:
+    HashTable<K, Entry> table;
+
+public:
+    /**
+     * @brief Construct empty set
+     */
+    Set() {}
+
+    Set(const Set&) = delete;
+    Set& operator=(const Set&) = delete;
+
+    /**
+     * @brief Add key if absent
+     * @returns true if the key was added
+     */
+    bool add(const K& key) {
+        uint64_t hash = HashTraits<K>::hash(key);
+        if (table.find(key, hash)) return false;
+        table.append(hash, key);
+        return true;
+    }
+
+    /**
+     * @brief Check if key is present
+     */
+    bool has(const K& key) const { return table.find(key) != nullptr; }
+
+    /**
+     * @brief Remove key (JS delete)
+     * @returns true if the key was present
+     */
+    bool remove(const K& key) { return table.remove(key); }
+
+    /**
+     * @brief Get number of keys
+     */
+    size_t getSize() const { return table.getSize(); }
+
+    /**
+     * @brief Get number of keys held before the storage has to grow
+     */
+    size_t getCapacity() const { return table.getCapacity(); }
+
+    /**
+     * @brief Check if set is empty
+     */
+    bool isEmpty() const { return table.getSize() == 0; }
+
+    /**
+     * @brief Remove all keys
+     */
+    void clear() { table.clear(); }
+
+    /**
+     * @brief Ensure room for n keys without rehashing
+     */
+    void reserve(size_t n) { table.reserve(n); }
+
+    /**
+     * @brief Call fn(key) for each key in insertion order
+     */
+    template<typename Fn>
+    void forEach(Fn fn) const {
+        table.forEach([&](const Entry& entry) { fn(entry.key); });
+    }
+
+    // ===== ITERATION =====
+    class iterator {
+    private:
+        typename HashTable<K, Entry>::iterator inner_;
+    public:
+        iterator(typename HashTable<K, Entry>::iterator inner) : inner_(inner) {}
+        const K& operator*() const { return (*inner_).key; }
+        iterator& operator++() { ++inner_; return *this; }
+        bool operator!=(const iterator& other) const { return inner_ != other.inner_; }
+    };
+
+    iterator begin() const { return iterator(table.begin()); }
+    iterator end() const { return iterator(table.end()); }
+};
+
+} // namespace Luna
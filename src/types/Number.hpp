@@ -105,8 +105,12 @@ public:
      * @brief Convert to integer (truncates float)
      */
     int32_t toInt() const;
-private:
+    
+    /**
+     * @brief Convert to double (exact for both representations)
+     */
     double toDouble() const;
+private:
     void intToString(int32_t value, char* buffer) const;
     void doubleToString(double value, char* buffer) const;
 };
\ No newline at end of file
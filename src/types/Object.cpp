@@ -0,0 +1,173 @@
+#include "Object.hpp"
+#include <new>
+
+// Shapes this small are searched by walking the transition chain
+static const size_t LINEAR_LOOKUP_LIMIT = 8;
+
+// ===== SHAPE =====
+
+Shape::Shape(Shape* parent, const Luna::std::string& key)
+    : parent(parent), key(key), key_hash(Luna::HashTraits<Luna::std::string>::hash(key)),
+      count(parent ? parent->count + 1 : 0), table(nullptr), keys(nullptr) {
+    pthread_mutex_init(&lock, nullptr);
+}
+
+Shape* Shape::root() {
+    // Initialized exactly once, whichever thread gets here first
+    static Shape* empty = new (Luna::Memory::allocate(sizeof(Shape))) Shape(nullptr, Luna::std::string());
+    return empty;
+}
+
+Shape* Shape::transition(const Luna::std::string& key) {
+    pthread_mutex_lock(&lock);
+    Shape** existing = transitions.get(key);
+    Shape* child = existing ? *existing : nullptr;
+    if (!child) {
+        child = (Shape*)Luna::Memory::allocate(sizeof(Shape));
+        new (child) Shape(this, key);
+        transitions.set(key, child);
+    }
+    pthread_mutex_unlock(&lock);
+    return child;
+}
+
+size_t Shape::lookup(const Luna::std::string& key) const {
+    if (count <= LINEAR_LOOKUP_LIMIT) {
+        uint64_t hash = Luna::HashTraits<Luna::std::string>::hash(key);
+        for (const Shape* shape = this; shape->parent; shape = shape->parent) {
+            if (shape->key_hash == hash && Luna::HashTraits<Luna::std::string>::equals(shape->key, key)) {
+                return shape->count - 1;
+            }
+        }
+        return npos;
+    }
+
+    typedef Luna::Map<Luna::std::string, size_t> SlotTable;
+    SlotTable* built = __atomic_load_n(&table, __ATOMIC_ACQUIRE);
+    if (!built) {
+        built = new (Luna::Memory::allocate(sizeof(SlotTable))) SlotTable();
+        built->reserve(count);
+        for (const Shape* shape = this; shape->parent; shape = shape->parent) {
+            built->set(shape->key, shape->count - 1);
+        }
+        // Threads may race to build it; the first to publish wins
+        SlotTable* published = nullptr;
+        if (!__atomic_compare_exchange_n(&table, &published, built, false, __ATOMIC_ACQ_REL, __ATOMIC_ACQUIRE)) {
+            built->~SlotTable();
+            Luna::Memory::deallocate(built);
+            built = published;
+        }
+    }
+    const size_t* slot = built->get(key);
+    return slot ? *slot : npos;
+}
+
+const Luna::std::string& Shape::keyAt(size_t slot) const {
+    const Luna::std::string** built = __atomic_load_n(&keys, __ATOMIC_ACQUIRE);
+    if (!built) {
+        built = (const Luna::std::string**)Luna::Memory::allocate(count * sizeof(Luna::std::string*));
+        for (const Shape* shape = this; shape->parent; shape = shape->parent) {
+            built[shape->count - 1] = &shape->key;
+        }
+        const Luna::std::string** published = nullptr;
+        if (!__atomic_compare_exchange_n(&keys, &published, built, false, __ATOMIC_ACQ_REL, __ATOMIC_ACQUIRE)) {
+            Luna::Memory::deallocate(built);
+            built = published;
+        }
+    }
+    return *built[slot];
+}
+
+// ===== OBJECT =====
+
+Object::Object() : shape(Shape::root()), overflow(nullptr), overflow_capacity(0) {}
+
+Object::~Object() {
+    Luna::Memory::deallocate(overflow);
+}
+
+void Object::transitionTo(Shape* next) {
+    size_t index = next->count - 1;
+    if (index >= INLINE_SLOTS && index - INLINE_SLOTS >= overflow_capacity) {
+        size_t new_capacity = overflow_capacity ? overflow_capacity * 2 : 4;
+        Value* grown = (Value*)Luna::Memory::allocate(new_capacity * sizeof(Value));
+        if (overflow) {
+            Luna::Memory::copy(grown, overflow, overflow_capacity * sizeof(Value));
+            Luna::Memory::deallocate(overflow);
+        }
+        overflow = grown;
+        overflow_capacity = new_capacity;
+    }
+    shape = next;
+    slot(index) = Value();
+}
+
+Value Object::get(const Luna::std::string& key) const {
+    size_t index = shape->lookup(key);
+    return index == Shape::npos ? Value() : slot(index);
+}
+
+void Object::set(const Luna::std::string& key, const Value& value) {
+    size_t index = shape->lookup(key);
+    if (index == Shape::npos) {
+        transitionTo(shape->transition(key));
+        index = shape->count - 1;
+    }
+    slot(index) = value;
+}
+
+bool Object::has(const Luna::std::string& key) const {
+    return shape->lookup(key) != Shape::npos;
+}
+
+bool Object::remove(const Luna::std::string& key) {
+    size_t removed = shape->lookup(key);
+    if (removed == Shape::npos) return false;
+
+    // Replay the remaining properties from the root: slots before the
+    // removed one keep their place, later ones move down by one
+    Shape* old_shape = shape;
+    Shape* rebuilt = Shape::root();
+    for (size_t i = 0; i < old_shape->count; i++) {
+        if (i == removed) continue;
+        rebuilt = rebuilt->transition(old_shape->keyAt(i));
+        if (i > removed) slot(i - 1) = slot(i);
+    }
+    shape = rebuilt;
+    return true;
+}
+
+// ===== PROPERTY CACHE =====
+
+PropertyCache::PropertyCache(const Luna::std::string& key) : key(key), count(0), megamorphic(false) {}
+
+void PropertyCache::remember(const Shape* before, Shape* after, size_t slot) {
+    if (megamorphic) return;
+    if (count == MAX_SHAPES) {
+        megamorphic = true;
+        count = 0;
+        return;
+    }
+    entries[count].before = before;
+    entries[count].after = after;
+    entries[count].slot = slot;
+    count++;
+}
+
+Value PropertyCache::getSlow(const Object& object) {
+    size_t index = object.shape->lookup(key);
+    if (index == Shape::npos) return Value();
+    remember(object.shape, object.shape, index);
+    return object.slot(index);
+}
+
+void PropertyCache::setSlow(Object& object, const Value& value) {
+    Shape* before = object.shape;
+    size_t index = before->lookup(key);
+    if (index == Shape::npos) {
+        object.transitionTo(before->transition(key));
+        index = object.shape->getCount() - 1;
+    }
+    remember(before, object.shape, index);
+    object.slot(index) = value;
+}
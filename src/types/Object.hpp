@@ -0,0 +1,273 @@
+#pragma once
+
+#include "lib/memory.hpp"
+#include "types/Number.hpp"
+#include "types/Array.hpp"
+#include "types/Strings.hpp"
+#include "types/Map.hpp"
+#include <pthread.h>
+
+/**
+ * @brief Property value: undefined, a Number, a string or an Array
+ *
+ * Numbers are held by value; strings and arrays by pointer and are not
+ * owned, as with Array elements.
+ */
+class Value {
+public:
+    enum Type : uint8_t { UNDEFINED, NUMBER, STRING, ARRAY };
+
+private:
+    Type type;
+    union {
+        Number number;
+        const Luna::std::string* text;
+        Array* array;
+    };
+
+public:
+    Value() : type(UNDEFINED), array(nullptr) {}
+    Value(const Number& value) : type(NUMBER), number(value) {}
+    Value(const Luna::std::string* value) : type(STRING), text(value) {}
+    Value(Array* value) : type(ARRAY), array(value) {}
+
+    Type getType() const { return type; }
+    bool isUndefined() const { return type == UNDEFINED; }
+    bool isNumber() const { return type == NUMBER; }
+    bool isString() const { return type == STRING; }
+    bool isArray() const { return type == ARRAY; }
+
+    /**
+     * @brief Number value (NaN when not a Number)
+     */
+    Number getNumber() const { return type == NUMBER ? number : Number::nan(); }
+
+    /**
+     * @brief String value (nullptr when not a string)
+     */
+    const Luna::std::string* getString() const { return type == STRING ? text : nullptr; }
+
+    /**
+     * @brief Array value (nullptr when not an Array)
+     */
+    Array* getArray() const { return type == ARRAY ? array : nullptr; }
+};
+
+/**
+ * @brief Hidden class: the ordered property layout shared by objects
+ *
+ * Shapes form a transition tree rooted at the empty shape. Adding key to
+ * an object moves it to the child shape for key, so objects built with
+ * the same keys in the same order share one Shape. Shapes live for the
+ * whole process and are shared by every thread: transitions are taken
+ * under a per-shape lock, and the lazily built lookup tables are
+ * published with a compare-and-swap.
+ */
+class Shape {
+    friend class Object;
+
+public:
+    static const size_t npos = (size_t)-1;
+
+private:
+    Shape* parent;
+    Luna::std::string key; // Property added by the transition into this shape
+    uint64_t key_hash;
+    size_t count;          // Properties in the layout; key lives in slot count - 1
+    pthread_mutex_t lock;  // Guards transitions
+    Luna::Map<Luna::std::string, Shape*> transitions;
+    mutable Luna::Map<Luna::std::string, size_t>* table; // Built on first lookup of a large shape
+    mutable const Luna::std::string** keys;              // Slot -> key, built on first keyAt
+
+    Shape(Shape* parent, const Luna::std::string& key);
+
+public:
+    Shape(const Shape&) = delete;
+    Shape& operator=(const Shape&) = delete;
+
+    /**
+     * @brief The empty shape every object starts from
+     */
+    static Shape* root();
+
+    /**
+     * @brief Child shape adding key (created on first use)
+     */
+    Shape* transition(const Luna::std::string& key);
+
+    /**
+     * @brief Slot holding key, or npos
+     */
+    size_t lookup(const Luna::std::string& key) const;
+
+    /**
+     * @brief Get number of properties
+     */
+    size_t getCount() const { return count; }
+
+    /**
+     * @brief Key stored in slot (slot < getCount())
+     */
+    const Luna::std::string& keyAt(size_t slot) const;
+};
+
+/**
+ * @brief JS object: a Shape plus slot storage
+ *
+ * The first INLINE_SLOTS properties live inside the object; the rest
+ * spill to a separately allocated array.
+ */
+class Object {
+    friend class PropertyCache;
+
+public:
+    static const size_t INLINE_SLOTS = 4;
+
+private:
+    Shape* shape;
+    Value inline_slots[INLINE_SLOTS];
+    Value* overflow;
+    size_t overflow_capacity;
+
+    Value& slot(size_t index) {
+        return index < INLINE_SLOTS ? inline_slots[index] : overflow[index - INLINE_SLOTS];
+    }
+    const Value& slot(size_t index) const {
+        return index < INLINE_SLOTS ? inline_slots[index] : overflow[index - INLINE_SLOTS];
+    }
+
+    /**
+     * @brief Move to a shape one property larger, making room for its slot
+     */
+    void transitionTo(Shape* next);
+
+public:
+    /**
+     * @brief Construct empty object
+     */
+    Object();
+
+    /**
+     * @brief Destroy object and free overflow slots
+     */
+    ~Object();
+
+    Object(const Object&) = delete;
+    Object& operator=(const Object&) = delete;
+
+    /**
+     * @brief Property value (undefined when absent)
+     */
+    Value get(const Luna::std::string& key) const;
+
+    /**
+     * @brief Add or overwrite a property
+     */
+    void set(const Luna::std::string& key, const Value& value);
+
+    /**
+     * @brief Check if property exists
+     */
+    bool has(const Luna::std::string& key) const;
+
+    /**
+     * @brief Remove a property (JS delete); rebuilds the layout without it
+     * @returns true if the property existed
+     */
+    bool remove(const Luna::std::string& key);
+
+    /**
+     * @brief Get the object's hidden class
+     */
+    const Shape* getShape() const { return shape; }
+
+    /**
+     * @brief Get number of properties
+     */
+    size_t getPropertyCount() const { return shape->getCount(); }
+
+    /**
+     * @brief Call fn(key, value) for each property in insertion order
+     */
+    template<typename Fn>
+    void forEach(Fn fn) const {
+        for (size_t i = 0; i < shape->getCount(); i++) fn(shape->keyAt(i), slot(i));
+    }
+};
+
+/**
+ * @brief Inline cache for one property access site
+ *
+ * Remembers up to MAX_SHAPES (shape, slot) pairs for its key; a hit is one
+ * shape compare plus one slot load. Cached stores also remember the
+ * transition an add takes. Past MAX_SHAPES the site goes megamorphic and
+ * falls back to Shape::lookup.
+ */
+class PropertyCache {
+public:
+    static const size_t MAX_SHAPES = 4;
+
+private:
+    struct Entry {
+        const Shape* before; // Shape the object must have
+        Shape* after;        // Shape after the access (differs for adds)
+        size_t slot;
+    };
+
+    Luna::std::string key;
+    Entry entries[MAX_SHAPES];
+    size_t count;
+    bool megamorphic;
+
+    void remember(const Shape* before, Shape* after, size_t slot);
+
+public:
+    /**
+     * @brief Construct cache for accesses to key
+     */
+    PropertyCache(const Luna::std::string& key);
+
+    /**
+     * @brief Read the property from object
+     */
+    Value get(const Object& object) {
+        for (size_t i = 0; i < count; i++) {
+            // An add's entry is valid for reads on the shape it produced
+            if (entries[i].after == object.shape) return object.slot(entries[i].slot);
+        }
+        return getSlow(object);
+    }
+
+    /**
+     * @brief Write the property on object, adding it if absent
+     */
+    void set(Object& object, const Value& value) {
+        for (size_t i = 0; i < count; i++) {
+            if (entries[i].before == object.shape) {
+                if (entries[i].after != object.shape) object.transitionTo(entries[i].after);
+                object.slot(entries[i].slot) = value;
+                return;
+            }
+        }
+        setSlow(object, value);
+    }
+
+    /**
+     * @brief Check if the site has seen exactly one shape
+     */
+    bool isMonomorphic() const { return !megamorphic && count == 1; }
+
+    /**
+     * @brief Check if the site caches several shapes
+     */
+    bool isPolymorphic() const { return !megamorphic && count > 1; }
+
+    /**
+     * @brief Check if the site gave up caching
+     */
+    bool isMegamorphic() const { return megamorphic; }
+
+private:
+    Value getSlow(const Object& object);
+    void setSlow(Object& object, const Value& value);
+};
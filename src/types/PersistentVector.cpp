@@ -0,0 +1,498 @@
+#include "PersistentVector.hpp"
+#include "lib/memory.hpp"
+
+// ===== NODES =====
+// Every internal node keeps cumulative child sizes, so lookup guesses the
+// radix slot and scans forward past any undersized (relaxed) children.
+// Node operations consume one reference to the node they are given and
+// return one reference to the result: a node nobody else holds is edited
+// in place, a shared node is copied first. Persistent operations retain
+// the root before calling them, which forces copies along the path.
+
+static const unsigned BITS = 5;
+static const unsigned BRANCHING = 1u << BITS;
+static const unsigned EXTRA_SLOTS = 2; // Search-step slack allowed by rebalancing
+
+struct PersistentVector::Node {
+    size_t refs;
+    unsigned count;
+    unsigned level; // 0 for leaves
+    void* slots[BRANCHING];
+    // Internal nodes are followed by size_t sizes[BRANCHING]
+};
+
+typedef PersistentVector::Node Node;
+
+static inline size_t* sizesOf(const Node* node) {
+    return (size_t*)(node + 1);
+}
+
+static Node* allocateNode(unsigned level) {
+    size_t bytes = sizeof(Node) + (level ? BRANCHING * sizeof(size_t) : 0);
+    Node* node = (Node*)Luna::Memory::allocate(bytes);
+    node->refs = 1;
+    node->count = 0;
+    node->level = level;
+    return node;
+}
+
+static inline Node* retain(Node* node) {
+    if (node) __atomic_add_fetch(&node->refs, 1, __ATOMIC_RELAXED);
+    return node;
+}
+
+static void release(Node* node) {
+    if (!node) return;
+    if (__atomic_sub_fetch(&node->refs, 1, __ATOMIC_ACQ_REL) != 0) return;
+    if (node->level) {
+        for (unsigned i = 0; i < node->count; i++) release((Node*)node->slots[i]);
+    }
+    Luna::Memory::deallocate(node);
+}
+
+static inline size_t nodeSize(const Node* node) {
+    return node->level ? sizesOf(node)[node->count - 1] : node->count;
+}
+
+static void updateSizes(Node* node, unsigned from) {
+    size_t* sizes = sizesOf(node);
+    size_t total = from ? sizes[from - 1] : 0;
+    for (unsigned i = from; i < node->count; i++) {
+        total += nodeSize((Node*)node->slots[i]);
+        sizes[i] = total;
+    }
+}
+
+static Node* copyNode(const Node* node) {
+    Node* copy = allocateNode(node->level);
+    copy->count = node->count;
+    Luna::Memory::copy(copy->slots, node->slots, node->count * sizeof(void*));
+    if (node->level) {
+        Luna::Memory::copy(sizesOf(copy), sizesOf(node), node->count * sizeof(size_t));
+        for (unsigned i = 0; i < node->count; i++) retain((Node*)node->slots[i]);
+    }
+    return copy;
+}
+
+/**
+ * @brief Node safe to mutate: itself if unshared, otherwise a copy
+ */
+static Node* editable(Node* node) {
+    if (__atomic_load_n(&node->refs, __ATOMIC_ACQUIRE) == 1) return node;
+    Node* copy = copyNode(node);
+    release(node);
+    return copy;
+}
+
+/**
+ * @brief Internal node at level over children (takes their references)
+ */
+static Node* makeInternal(unsigned level, Node* const* children, unsigned count) {
+    Node* node = allocateNode(level);
+    node->count = count;
+    for (unsigned i = 0; i < count; i++) node->slots[i] = children[i];
+    updateSizes(node, 0);
+    return node;
+}
+
+/**
+ * @brief Child slot holding index; index becomes relative to that child
+ */
+static inline unsigned findSlot(const Node* node, size_t* index) {
+    const size_t* sizes = sizesOf(node);
+    // Children hold at most 32^level elements, so the radix guess is never past the answer
+    unsigned slot = (unsigned)(*index >> (BITS * node->level));
+    while (sizes[slot] <= *index) slot++;
+    if (slot) *index -= sizes[slot - 1];
+    return slot;
+}
+
+/**
+ * @brief Unwrap single-child roots
+ */
+static Node* strip(Node* node) {
+    while (node && node->level && node->count == 1) {
+        Node* child = retain((Node*)node->slots[0]);
+        release(node);
+        node = child;
+    }
+    return node;
+}
+
+// ===== UPDATE =====
+
+static Node* setIn(Node* node, size_t index, void* value) {
+    node = editable(node);
+    if (!node->level) {
+        node->slots[index] = value;
+        return node;
+    }
+    unsigned slot = findSlot(node, &index);
+    node->slots[slot] = setIn((Node*)node->slots[slot], index, value);
+    return node;
+}
+
+/**
+ * @brief True when no element can be appended below node
+ */
+static bool isFull(const Node* node) {
+    while (node->level) {
+        if (node->count < BRANCHING) return false;
+        node = (const Node*)node->slots[node->count - 1];
+    }
+    return node->count == BRANCHING;
+}
+
+/**
+ * @brief Chain of single-child nodes from level down to a leaf holding value
+ */
+static Node* newPath(unsigned level, void* value) {
+    Node* node = allocateNode(0);
+    node->slots[0] = value;
+    node->count = 1;
+    for (unsigned l = 1; l <= level; l++) {
+        Node* child = node;
+        node = makeInternal(l, &child, 1);
+    }
+    return node;
+}
+
+static Node* appendIn(Node* node, void* value) {
+    node = editable(node);
+    if (!node->level) {
+        node->slots[node->count++] = value;
+        return node;
+    }
+
+    unsigned last = node->count - 1;
+    if (!isFull((Node*)node->slots[last])) {
+        node->slots[last] = appendIn((Node*)node->slots[last], value);
+        sizesOf(node)[last]++;
+    } else {
+        node->slots[node->count] = newPath(node->level - 1, value);
+        sizesOf(node)[node->count] = sizesOf(node)[last] + 1;
+        node->count++;
+    }
+    return node;
+}
+
+static Node* pushRoot(Node* root, void* value) {
+    if (!root) return newPath(0, value);
+    if (!isFull(root)) return appendIn(root, value);
+
+    Node* children[2] = { root, newPath(root->level, value) };
+    return makeInternal(root->level + 1, children, 2);
+}
+
+/**
+ * @brief Keep the first count elements (1 <= count <= size)
+ */
+static Node* takeIn(Node* node, size_t count) {
+    if (count == nodeSize(node)) return node;
+    node = editable(node);
+    if (!node->level) {
+        node->count = (unsigned)count;
+        return node;
+    }
+
+    size_t last_index = count - 1;
+    unsigned slot = findSlot(node, &last_index);
+    for (unsigned i = slot + 1; i < node->count; i++) release((Node*)node->slots[i]);
+    node->count = slot + 1;
+    node->slots[slot] = takeIn((Node*)node->slots[slot], last_index + 1);
+    sizesOf(node)[slot] = count;
+    return node;
+}
+
+/**
+ * @brief Drop the first count elements (count < size)
+ */
+static Node* dropIn(Node* node, size_t count) {
+    if (count == 0) return node;
+    node = editable(node);
+    if (!node->level) {
+        Luna::Memory::move(node->slots, node->slots + count, (node->count - count) * sizeof(void*));
+        node->count -= (unsigned)count;
+        return node;
+    }
+
+    size_t first_index = count;
+    unsigned slot = findSlot(node, &first_index);
+    for (unsigned i = 0; i < slot; i++) release((Node*)node->slots[i]);
+    Luna::Memory::move(node->slots, node->slots + slot, (node->count - slot) * sizeof(void*));
+    node->count -= slot;
+    node->slots[0] = dropIn((Node*)node->slots[0], first_index);
+    updateSizes(node, 0);
+    return node;
+}
+
+// ===== CONCATENATION =====
+
+/**
+ * @brief Redistribute slots so children[0..count) stay within EXTRA_SLOTS of optimal
+ * @returns New number of children
+ *
+ * Follows the RRB concatenation plan: skip nearly full nodes, then pour
+ * the first undersized node's slots into its right neighbours until one
+ * node disappears. Children whose contents are untouched are reused.
+ */
+static unsigned rebalance(Node** children, unsigned count, unsigned child_level) {
+    unsigned counts[3 * BRANCHING];
+    unsigned total = 0;
+    for (unsigned i = 0; i < count; i++) {
+        counts[i] = children[i]->count;
+        total += counts[i];
+    }
+
+    unsigned optimal = (total + BRANCHING - 1) / BRANCHING;
+    if (count <= optimal + EXTRA_SLOTS) return count;
+
+    unsigned planned = count;
+    unsigned i = 0;
+    while (planned > optimal + EXTRA_SLOTS) {
+        while (counts[i] >= BRANCHING - EXTRA_SLOTS / 2) i++;
+
+        unsigned remaining = counts[i];
+        while (remaining > 0 && i + 1 < planned) {
+            unsigned combined = remaining + counts[i + 1];
+            counts[i] = combined < BRANCHING ? combined : BRANCHING;
+            remaining = combined - counts[i];
+            i++;
+        }
+
+        for (unsigned j = i; j + 1 < planned; j++) counts[j] = counts[j + 1];
+        planned--;
+        if (i > 0) i--;
+    }
+
+    // Stream the old children's slots into nodes of the planned sizes
+    Node* result[3 * BRANCHING];
+    unsigned source = 0;
+    unsigned offset = 0;
+    for (unsigned p = 0; p < planned; p++) {
+        if (offset == 0 && children[source]->count == counts[p]) {
+            result[p] = children[source++];
+            continue;
+        }
+
+        Node* node = allocateNode(child_level);
+        while (node->count < counts[p]) {
+            Node* from = children[source];
+            unsigned take = from->count - offset;
+            if (take > counts[p] - node->count) take = counts[p] - node->count;
+
+            for (unsigned t = 0; t < take; t++) {
+                void* slot = from->slots[offset + t];
+                if (child_level) retain((Node*)slot);
+                node->slots[node->count++] = slot;
+            }
+
+            offset += take;
+            if (offset == from->count) {
+                release(from);
+                source++;
+                offset = 0;
+            }
+        }
+        if (child_level) updateSizes(node, 0);
+        result[p] = node;
+    }
+
+    for (unsigned p = 0; p < planned; p++) children[p] = result[p];
+    return planned;
+}
+
+/**
+ * @brief Concatenate two trees of the same level
+ * @returns Node at level + 1 with one or two children
+ */
+static Node* mergeLevel(Node* left, Node* right, unsigned level) {
+    if (level == 0) {
+        if (left->count + right->count <= BRANCHING) {
+            left = editable(left);
+            Luna::Memory::copy(left->slots + left->count, right->slots, right->count * sizeof(void*));
+            left->count += right->count;
+            release(right);
+            return makeInternal(1, &left, 1);
+        }
+        Node* pair[2] = { left, right };
+        return makeInternal(1, pair, 2);
+    }
+
+    // Left's inner children + merged seam + right's inner children (at most 64)
+    Node* children[3 * BRANCHING];
+    unsigned count = 0;
+    for (unsigned i = 0; i + 1 < left->count; i++) children[count++] = retain((Node*)left->slots[i]);
+
+    Node* seam = mergeLevel(retain((Node*)left->slots[left->count - 1]),
+                            retain((Node*)right->slots[0]), level - 1);
+    for (unsigned i = 0; i < seam->count; i++) children[count++] = retain((Node*)seam->slots[i]);
+    release(seam);
+
+    for (unsigned i = 1; i < right->count; i++) children[count++] = retain((Node*)right->slots[i]);
+    release(left);
+    release(right);
+
+    count = rebalance(children, count, level - 1);
+
+    if (count <= BRANCHING) {
+        Node* only = makeInternal(level, children, count);
+        return makeInternal(level + 1, &only, 1);
+    }
+    Node* halves[2] = {
+        makeInternal(level, children, BRANCHING),
+        makeInternal(level, children + BRANCHING, count - BRANCHING)
+    };
+    return makeInternal(level + 1, halves, 2);
+}
+
+// ===== READ =====
+
+static void* getIn(const Node* node, size_t index) {
+    while (node->level) {
+        unsigned slot = findSlot(node, &index);
+        node = (const Node*)node->slots[slot];
+    }
+    return node->slots[index];
+}
+
+static void collect(const Node* node, Array* out) {
+    if (!node->level) {
+        out->pushAll((const void* const*)node->slots, node->count);
+        return;
+    }
+    for (unsigned i = 0; i < node->count; i++) collect((const Node*)node->slots[i], out);
+}
+
+// ===== PERSISTENT VECTOR =====
+
+PersistentVector::PersistentVector() : root(nullptr), length(0) {}
+
+PersistentVector::PersistentVector(Node* root, size_t length) : root(root), length(length) {}
+
+PersistentVector::PersistentVector(const PersistentVector& other)
+    : root(retain(other.root)), length(other.length) {}
+
+PersistentVector& PersistentVector::operator=(const PersistentVector& other) {
+    Node* previous = root;
+    root = retain(other.root);
+    length = other.length;
+    release(previous);
+    return *this;
+}
+
+PersistentVector::~PersistentVector() {
+    release(root);
+}
+
+void* PersistentVector::get(size_t index) const {
+    if (index >= length) return nullptr;
+    return getIn(root, index);
+}
+
+PersistentVector PersistentVector::set(size_t index, void* value) const {
+    if (index >= length) return *this;
+    return PersistentVector(setIn(retain(root), index, value), length);
+}
+
+PersistentVector PersistentVector::push(void* value) const {
+    return PersistentVector(pushRoot(retain(root), value), length + 1);
+}
+
+PersistentVector PersistentVector::pop() const {
+    if (length == 0) return *this;
+    return slice(0, length - 1);
+}
+
+PersistentVector PersistentVector::concat(const PersistentVector& other) const {
+    if (!root) return other;
+    if (!other.root) return *this;
+
+    Node* left = retain(root);
+    Node* right = retain(other.root);
+
+    // Lift the shorter tree with single-child nodes; the merge absorbs them
+    while (left->level < right->level) {
+        Node* child = left;
+        left = makeInternal(child->level + 1, &child, 1);
+    }
+    while (right->level < left->level) {
+        Node* child = right;
+        right = makeInternal(child->level + 1, &child, 1);
+    }
+
+    Node* merged = mergeLevel(left, right, left->level);
+    return PersistentVector(strip(merged), length + other.length);
+}
+
+PersistentVector PersistentVector::slice(size_t begin, size_t end) const {
+    if (end > length) end = length;
+    if (begin >= end) return PersistentVector();
+
+    Node* node = retain(root);
+    if (end < length) node = takeIn(node, end);
+    if (begin > 0) node = dropIn(node, begin);
+    return PersistentVector(strip(node), end - begin);
+}
+
+TransientVector PersistentVector::transient() const {
+    return TransientVector(retain(root), length);
+}
+
+Array* PersistentVector::toArray() const {
+    Array* result = new Array(length ? length : 1);
+    if (root) collect(root, result);
+    return result;
+}
+
+void* const* PersistentVector::leafFor(size_t index, size_t* leaf_start, size_t* leaf_length) const {
+    const Node* node = root;
+    size_t local = index;
+    while (node->level) {
+        unsigned slot = findSlot(node, &local);
+        node = (const Node*)node->slots[slot];
+    }
+    *leaf_start = index - local;
+    *leaf_length = node->count;
+    return node->slots;
+}
+
+// ===== TRANSIENT VECTOR =====
+
+TransientVector::TransientVector() : root(nullptr), length(0) {}
+
+TransientVector::TransientVector(Node* root, size_t length) : root(root), length(length) {}
+
+TransientVector::~TransientVector() {
+    release(root);
+}
+
+void* TransientVector::get(size_t index) const {
+    if (index >= length) return nullptr;
+    return getIn(root, index);
+}
+
+void TransientVector::push(void* value) {
+    root = pushRoot(root, value);
+    length++;
+}
+
+void TransientVector::set(size_t index, void* value) {
+    if (index >= length) return;
+    root = setIn(root, index, value);
+}
+
+void TransientVector::pop() {
+    if (length == 0) return;
+    length--;
+    if (length == 0) {
+        release(root);
+        root = nullptr;
+        return;
+    }
+    root = strip(takeIn(root, length));
+}
+
+PersistentVector TransientVector::persistent() const {
+    return PersistentVector(retain(root), length);
+}
@@ -0,0 +1,193 @@
+#pragma once
+
+#include "lib/memory.hpp"
+#include "types/Array.hpp"
+
+class TransientVector;
+
+/**
+ * @brief Immutable vector of pointers (relaxed radix-balanced tree, 32-way)
+ *
+ * Updates return a new vector that shares every untouched node with the
+ * old one, so copies and snapshots are O(1) and updates are O(log32 n).
+ * Nodes are reference counted; elements are not owned.
+ */
+class PersistentVector {
+    friend class TransientVector;
+
+public:
+    struct Node;
+    static const size_t npos = (size_t)-1;
+
+private:
+    Node* root;
+    size_t length;
+
+    /**
+     * @brief Adopt one reference to root
+     */
+    PersistentVector(Node* root, size_t length);
+
+public:
+    /**
+     * @brief Construct empty vector
+     */
+    PersistentVector();
+
+    /**
+     * @brief Snapshot: shares the tree, O(1)
+     */
+    PersistentVector(const PersistentVector& other);
+    PersistentVector& operator=(const PersistentVector& other);
+
+    /**
+     * @brief Release this vector's reference to the tree
+     */
+    ~PersistentVector();
+
+    /**
+     * @brief Get element at index (nullptr when out of range)
+     */
+    void* get(size_t index) const;
+
+    /**
+     * @brief Get number of elements
+     */
+    size_t getLength() const { return length; }
+
+    /**
+     * @brief Check if vector is empty
+     */
+    bool isEmpty() const { return length == 0; }
+
+    /**
+     * @brief Vector with element at index replaced (unchanged if out of range)
+     */
+    PersistentVector set(size_t index, void* value) const;
+
+    /**
+     * @brief Vector with value appended
+     */
+    PersistentVector push(void* value) const;
+
+    /**
+     * @brief Vector without its last element
+     */
+    PersistentVector pop() const;
+
+    /**
+     * @brief Vector of this followed by other, sharing both trees
+     */
+    PersistentVector concat(const PersistentVector& other) const;
+
+    /**
+     * @brief Vector of elements in [begin, end), sharing the tree
+     */
+    PersistentVector slice(size_t begin = 0, size_t end = npos) const;
+
+    /**
+     * @brief Mutable builder starting from this vector's contents
+     */
+    TransientVector transient() const;
+
+    /**
+     * @brief Copy elements into a new Array (caller manages memory)
+     */
+    Array* toArray() const;
+
+    /**
+     * @brief Contiguous leaf holding index
+     * @param leaf_start - Receives the index of the leaf's first element
+     * @param leaf_length - Receives the number of elements in the leaf
+     */
+    void* const* leafFor(size_t index, size_t* leaf_start, size_t* leaf_length) const;
+
+    // ===== ITERATION =====
+    // Walks one leaf at a time, so advancing is O(1) amortized.
+    class iterator {
+    private:
+        const PersistentVector* owner_;
+        size_t index_;
+        void* const* leaf_;
+        size_t leaf_start_;
+        size_t leaf_length_;
+    public:
+        iterator(const PersistentVector* owner, size_t index)
+            : owner_(owner), index_(index), leaf_(nullptr), leaf_start_(0), leaf_length_(0) {
+            if (index_ < owner_->length) leaf_ = owner_->leafFor(index_, &leaf_start_, &leaf_length_);
+        }
+        void* operator*() const { return leaf_[index_ - leaf_start_]; }
+        iterator& operator++() {
+            index_++;
+            if (index_ - leaf_start_ >= leaf_length_ && index_ < owner_->length) {
+                leaf_ = owner_->leafFor(index_, &leaf_start_, &leaf_length_);
+            }
+            return *this;
+        }
+        bool operator!=(const iterator& other) const { return index_ != other.index_; }
+    };
+
+    iterator begin() const { return iterator(this, 0); }
+    iterator end() const { return iterator(this, length); }
+};
+
+/**
+ * @brief Builder for PersistentVector that edits nodes in place
+ *
+ * Nodes only this builder references are mutated directly; nodes shared
+ * with a PersistentVector are copied on first write. persistent() can be
+ * called at any time and the builder stays usable afterwards.
+ */
+class TransientVector {
+    friend class PersistentVector;
+
+private:
+    PersistentVector::Node* root;
+    size_t length;
+
+    TransientVector(PersistentVector::Node* root, size_t length);
+
+public:
+    /**
+     * @brief Construct empty builder
+     */
+    TransientVector();
+
+    /**
+     * @brief Release the builder's reference to the tree
+     */
+    ~TransientVector();
+
+    TransientVector(const TransientVector&) = delete;
+    TransientVector& operator=(const TransientVector&) = delete;
+
+    /**
+     * @brief Get element at index (nullptr when out of range)
+     */
+    void* get(size_t index) const;
+
+    /**
+     * @brief Get number of elements
+     */
+    size_t getLength() const { return length; }
+
+    /**
+     * @brief Append value in place
+     */
+    void push(void* value);
+
+    /**
+     * @brief Replace element at index in place
+     */
+    void set(size_t index, void* value);
+
+    /**
+     * @brief Remove the last element in place
+     */
+    void pop();
+
+    /**
+     * @brief Snapshot of the current contents
+     */
+    PersistentVector persistent() const;
+};
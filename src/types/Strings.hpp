@@ -1,7 +1,11 @@
 #pragma once
 
 #include "types/Array.hpp"
+#include "types/ArrayOf.hpp"
 #include "lib/memory.hpp"
+#include "lib/unicode.hpp"
+#include "lib/intern.hpp"
+#include "lib/search.hpp"
 
 namespace Luna {
 
@@ -54,58 +58,363 @@ namespace string {
     char* fromDouble(double value);
 }
 
+namespace std {
+    class string;
+}
+
+// ===== STRING VIEWS =====
+/**
+ * @brief Non-owning view of bytes: a pointer plus a length
+ *
+ * Views never allocate or copy. The viewed bytes must stay alive and in
+ * place, so modifying a string invalidates views into it. The bytes are
+ * not NUL-terminated.
+ */
+class StringView {
+private:
+    const char* ptr_;
+    size_t length_;
+
+public:
+    static const size_t npos = (size_t)-1;
+
+    StringView() : ptr_(""), length_(0) {}
+    StringView(const char* data, size_t length) : ptr_(data), length_(length) {}
+    StringView(const char* cstr);
+    StringView(const std::string& str);
+
+    const char* data() const { return ptr_; }
+    size_t length() const { return length_; }
+    size_t size() const { return length_; }
+    bool empty() const { return length_ == 0; }
+    char operator[](size_t pos) const { return ptr_[pos]; }
+
+    /**
+     * @brief View of up to len bytes from pos
+     */
+    StringView substr(size_t pos, size_t len = npos) const;
+
+    /**
+     * @brief View without leading and trailing whitespace
+     */
+    StringView trim() const;
+
+    /**
+     * @brief Split on delimiter into at most limit views of the same bytes
+     *        (caller manages memory)
+     */
+    ArrayOf<StringView>* split(StringView delimiter, size_t limit = npos) const;
+
+    size_t find(StringView str, size_t pos = 0) const;
+    size_t find(char ch, size_t pos = 0) const;
+
+    /**
+     * @brief Start of the last match at or before pos (JS lastIndexOf), or npos
+     */
+    size_t lastIndexOf(StringView str, size_t pos = npos) const;
+
+    bool startsWith(StringView prefix) const;
+    bool endsWith(StringView suffix) const;
+    bool includes(StringView search) const;
+
+    int toInt() const;
+    double toDouble() const;
+
+    /**
+     * @brief Compare bytes
+     * @returns 0 if equal, <0 if this sorts first, >0 otherwise
+     */
+    int compare(StringView other) const;
+
+    /**
+     * @brief Owning copy of the viewed bytes
+     */
+    std::string toString() const;
+};
+
+bool operator==(StringView lhs, StringView rhs);
+bool operator!=(StringView lhs, StringView rhs);
+bool operator<(StringView lhs, StringView rhs);
+bool operator>(StringView lhs, StringView rhs);
+bool operator<=(StringView lhs, StringView rhs);
+bool operator>=(StringView lhs, StringView rhs);
+
+/**
+ * @brief Streams the fields between delimiters one at a time
+ *
+ * Each field is a view into the split text (its offset is
+ * field.data() - text.data()), so splitting allocates nothing. The
+ * delimiter is one string, or with anyOf any single byte from a set. At
+ * most limit fields are produced, as with JS split(separator, limit); an
+ * empty delimiter yields the whole text as one field. Neither the text nor
+ * the delimiter is copied.
+ */
+class Splitter {
+private:
+    StringView text;
+    StringView delimiter;
+    Searcher searcher;     // Delimiter string, for multi-byte delimiters
+    uint64_t byte_set[4];  // Delimiter bytes, for anyOf
+    bool any;
+    size_t position;       // Start of the next field, or npos once done
+    size_t remaining;      // Fields the limit still allows
+
+    Splitter(StringView text, StringView delimiter, size_t limit, bool any);
+
+    /**
+     * @brief First delimiter at or after from, or npos
+     */
+    size_t findDelimiter(size_t from) const;
+
+public:
+    static const size_t npos = (size_t)-1;
+
+    /**
+     * @brief Split text on each occurrence of delimiter
+     */
+    Splitter(StringView text, StringView delimiter, size_t limit = npos)
+        : Splitter(text, delimiter, limit, false) {}
+
+    /**
+     * @brief Split text on any byte in delimiters
+     */
+    static Splitter anyOf(StringView text, StringView delimiters, size_t limit = npos) {
+        return Splitter(text, delimiters, limit, true);
+    }
+
+    /**
+     * @brief Produce the next field
+     * @returns false once every field has been produced
+     */
+    bool next(StringView* field);
+
+    /**
+     * @brief Call fn(field) for each remaining field
+     * @returns Number of fields visited
+     */
+    template<typename Fn>
+    size_t forEach(Fn fn) {
+        size_t visited = 0;
+        StringView field;
+        while (next(&field)) {
+            fn(field);
+            visited++;
+        }
+        return visited;
+    }
+
+    class iterator {
+    private:
+        Splitter* owner;
+        StringView field;
+        bool done;
+    public:
+        iterator(Splitter* owner) : owner(owner), done(!owner || !owner->next(&field)) {}
+        StringView operator*() const { return field; }
+        iterator& operator++() { done = !owner->next(&field); return *this; }
+        bool operator!=(const iterator& other) const { return done != other.done; }
+    };
+
+    /**
+     * @brief Iterate the remaining fields (single pass)
+     */
+    iterator begin() { return iterator(this); }
+    iterator end() { return iterator(nullptr); }
+};
+
 // ===== TYPESCRIPT STRING TYPE =====
 namespace std {
     // For substring operations
     static const size_t npos = -1;
     
+    struct RopeNode; // Defined in Strings.cpp
+    
     class string {
     private:
-        char* data_;
-        size_t length_;
-        size_t capacity_;
+        // Strings of up to SMALL_CAPACITY bytes live inside the object. The
+        // last byte tells the layouts apart: inline, it holds
+        // SMALL_CAPACITY - length, so it doubles as the terminator of a full
+        // buffer; on the heap it is the top byte of capacity, which carries
+        // HEAP_FLAG (x86-64 is little-endian). A rope is a heap string whose
+        // data points at a RopeNode and whose capacity also has ROPE_FLAG;
+        // const reads never change the layout, so they are safe to share.
+        static const size_t SMALL_CAPACITY = 23;
+        static const size_t HEAP_FLAG = (size_t)1 << 63;
+        static const size_t ROPE_FLAG = (size_t)1 << 62;
+        
+        struct Heap {
+            char* data;
+            size_t length;
+            size_t capacity; // Usable bytes, excluding the terminator (a rope's length), | HEAP_FLAG
+        };
+        
+        union {
+            Heap heap_;
+            char small_[sizeof(Heap)];
+        };
+        
+        bool isSmall() const { return ((unsigned char)small_[SMALL_CAPACITY] & 0x80) == 0; }
+        char* buffer() {
+            if (isRope()) flatten();
+            return isSmall() ? small_ : heap_.data;
+        }
         
         /**
-         * @brief Resize internal buffer
+         * @brief Become the empty inline string (does not free)
+         */
+        void setEmpty() {
+            small_[0] = '\0';
+            small_[SMALL_CAPACITY] = (char)SMALL_CAPACITY;
+        }
+        
+        /**
+         * @brief Set length to n and write the terminator (n must fit)
+         */
+        void setLength(size_t n);
+        
+        /**
+         * @brief Replace contents with n bytes from src
+         */
+        void assign(const char* src, size_t n);
+        
+        /**
+         * @brief Ensure room for new_capacity bytes including the terminator,
+         *        at least doubling the buffer when it has to grow
          */
         void resize(size_t new_capacity);
         
+        /**
+         * @brief Move contents to a heap buffer of exactly bytes (> length)
+         */
+        void reallocate(size_t bytes);
+        
+        /**
+         * @brief Turn the rope into a plain heap buffer, ready for writing
+         */
+        void flatten();
+        
+        /**
+         * @brief Rope bytes in one buffer, built once and cached on the node
+         */
+        const char* ropeText() const;
+        
+        /**
+         * @brief Take a reference to the rope node (becomes a rope string)
+         */
+        void adoptRope(RopeNode* node);
+        
+        /**
+         * @brief Rope node for the contents: shared if a rope, else a new leaf
+         */
+        RopeNode* toRope() const;
+        
+        /**
+         * @brief Free the heap buffer or drop the rope reference (does not reset)
+         */
+        void releaseStorage();
+        
     public:
         // ===== CONSTRUCTORS/DESTRUCTOR =====
         string();
         string(const char* cstr);
         string(const string& other);
+        string(string&& other);
         string(char ch);
+        string(const char* data, size_t length);
         ~string();
         
         // ===== CAPACITY =====
-        size_t length() const { return length_; }
-        size_t size() const { return length_; }
-        bool empty() const { return length_ == 0; }
+        size_t length() const {
+            return isSmall() ? SMALL_CAPACITY - (unsigned char)small_[SMALL_CAPACITY] : heap_.length;
+        }
+        size_t size() const { return length(); }
+        bool empty() const { return length() == 0; }
         void clear();
         
+        /**
+         * @brief Bytes the string can hold without reallocating
+         */
+        size_t capacity() const { return isSmall() ? SMALL_CAPACITY : (heap_.capacity & ~(HEAP_FLAG | ROPE_FLAG)); }
+        
+        /**
+         * @brief Ensure capacity for at least n bytes
+         */
+        void reserve(size_t n);
+        
+        /**
+         * @brief Release unused capacity (moves back inline when short enough)
+         */
+        void shrink_to_fit();
+        
+        /**
+         * @brief Check if the contents are a rope not yet written to
+         */
+        bool isRope() const { return ((unsigned char)small_[SMALL_CAPACITY] & 0x40) != 0; }
+        
         // ===== ELEMENT ACCESS =====
-        const char* c_str() const { return data_ ? data_ : ""; }
+        const char* c_str() const {
+            if (isRope()) return ropeText();
+            return isSmall() ? small_ : heap_.data;
+        }
         char& operator[](size_t pos);
         const char& operator[](size_t pos) const;
         char at(size_t pos) const;
         
         // ===== MODIFICATION =====
         string& operator=(const string& other);
+        string& operator=(string&& other);
         string& operator=(const char* cstr);
         string& operator+=(const string& other);
         string& operator+=(const char* cstr);
         string& operator+=(char ch);
         
+        /**
+         * @brief Exchange contents with other without copying
+         */
+        void swap(string& other);
+        
         void push_back(char ch);
         void append(const string& other);
         void append(const char* cstr);
         
+        /**
+         * @brief JS concat: long results are ropes, copied once when first read
+         */
+        string concat(const string& other) const;
+        
+        /**
+         * @brief Canonical handle for these bytes from the global intern table
+         */
+        Interned intern() const;
+        
         // ===== TYPESCRIPT-SPECIFIC METHODS =====
         string substr(size_t pos, size_t len = npos) const;
+        
+        // ===== VIEWS (valid until the string is modified) =====
+        StringView view() const { return StringView(c_str(), length()); }
+        StringView substrView(size_t pos, size_t len = npos) const { return view().substr(pos, len); }
+        StringView trimView() const { return view().trim(); }
+        
+        /**
+         * @brief Split on delimiter into views of this string (caller manages memory)
+         */
+        ArrayOf<StringView>* splitView(StringView delimiter, size_t limit = npos) const {
+            return view().split(delimiter, limit);
+        }
+        
         size_t find(const string& str, size_t pos = 0) const;
         size_t find(char ch, size_t pos = 0) const;
         
+        /**
+         * @brief Start of the last match at or before pos (JS lastIndexOf), or npos
+         */
+        size_t lastIndexOf(const string& str, size_t pos = npos) const;
+        
+        /**
+         * @brief Number of non-overlapping occurrences of str
+         */
+        size_t count(const string& str) const;
+        
         string toUpperCase() const;
         string toLowerCase() const;
         string trim() const;
@@ -114,9 +423,35 @@ namespace std {
         bool endsWith(const string& suffix) const;
         bool includes(const string& search) const;
         
-        Array* split(const string& delimiter) const;
+        /**
+         * @brief Split on delimiter into at most limit strings; the Array owns
+         *        its new strings (caller manages memory)
+         */
+        Array* split(const string& delimiter, size_t limit = npos) const;
+        
+        /**
+         * @brief Replace the first occurrence of search (JS replace; replacement is literal)
+         */
         string replace(const string& search, const string& replacement) const;
         
+        /**
+         * @brief Replace every non-overlapping occurrence of search (JS replaceAll);
+         *        an empty search inserts replacement around every code point
+         */
+        string replaceAll(const string& search, const string& replacement) const;
+        
+        /**
+         * @brief Replace patterns[i] with replacements[i] left to right; where
+         *        patterns overlap, the leftmost-longest match wins (see
+         *        MultiSearcher for the cost of long patterns next to short ones)
+         */
+        string replaceMany(const string* patterns, const string* replacements, size_t count) const;
+        
+        /**
+         * @brief replaceMany with a prebuilt automaton, for reuse across strings
+         */
+        string replaceMany(const MultiSearcher& patterns, const string* replacements) const;
+        
         // ===== CONVERSION =====
         int toInt() const;
         double toDouble() const;
@@ -133,14 +468,81 @@ namespace std {
             bool operator!=(const iterator& other) { return ptr_ != other.ptr_; }
         };
         
-        iterator begin() { return iterator(data_); }
-        iterator end() { return iterator(data_ + length_); }
+        iterator begin() { return iterator(buffer()); }
+        iterator end() { return iterator(buffer() + length()); }
+        
+        // ===== UNICODE =====
+        /**
+         * @brief Check that the bytes are well-formed UTF-8
+         */
+        bool isValidUtf8() const;
+        
+        /**
+         * @brief Number of code points (assumes valid UTF-8)
+         */
+        size_t codePointLength() const;
+        
+        /**
+         * @brief Number of UTF-16 code units, i.e. the JS length (assumes valid UTF-8)
+         */
+        size_t utf16Length() const;
+        
+        /**
+         * @brief Transcode to UTF-16 (caller manages memory)
+         * @returns nullptr if the string is not valid UTF-8
+         */
+        uint16_t* toUtf16(size_t* out_length) const;
+        
+        /**
+         * @brief Build string from UTF-16 (empty on unpaired surrogate)
+         */
+        static string fromUtf16(const uint16_t* units, size_t length);
+        
+        /**
+         * @brief Iterates code points; malformed bytes yield U+FFFD one at a time
+         */
+        class code_point_iterator {
+        private:
+            const char* ptr_;
+            const char* end_;
+            uint32_t code_point_;
+            size_t width_;
+            
+            void decodeCurrent() {
+                code_point_ = Unicode::decode(ptr_, (size_t)(end_ - ptr_), &width_);
+            }
+        public:
+            code_point_iterator(const char* ptr, const char* end) : ptr_(ptr), end_(end), code_point_(0), width_(0) {
+                if (ptr_ != end_) decodeCurrent();
+            }
+            uint32_t operator*() const { return code_point_; }
+            code_point_iterator& operator++() {
+                ptr_ += width_;
+                if (ptr_ != end_) decodeCurrent();
+                return *this;
+            }
+            bool operator!=(const code_point_iterator& other) const { return ptr_ != other.ptr_; }
+        };
+        
+        class code_point_range {
+        private:
+            const char* begin_;
+            const char* end_;
+        public:
+            code_point_range(const char* begin, const char* end) : begin_(begin), end_(end) {}
+            code_point_iterator begin() const { return code_point_iterator(begin_, end_); }
+            code_point_iterator end() const { return code_point_iterator(end_, end_); }
+        };
+        
+        code_point_range codePoints() const { return code_point_range(c_str(), c_str() + length()); }
     };
     
     // ===== NON-MEMBER OPERATORS =====
     string operator+(const string& lhs, const string& rhs);
     string operator+(const string& lhs, const char* rhs);
     string operator+(const char* lhs, const string& rhs);
+    string operator+(string&& lhs, const string& rhs);
+    string operator+(string&& lhs, const char* rhs);
     
     bool operator==(const string& lhs, const string& rhs);
     bool operator==(const string& lhs, const char* rhs);
@@ -156,4 +558,6 @@ namespace std {
     bool operator>=(const string& lhs, const string& rhs);
 }
 
+inline StringView::StringView(const std::string& str) : ptr_(str.c_str()), length_(str.length()) {}
+
 } // namespace Luna
\ No newline at end of file